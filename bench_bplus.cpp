@@ -0,0 +1,303 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+#include "bplus_tree.h"
+#include "memory_stats.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// GCC mengira free() di bawah tidak cocok dengan new, padahal operator new juga diganti di sini.
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+// Penghitung byte heap: semua operator new/delete di program ini lewat sini,
+// jadi selisih sebelum/sesudah build = byte yang benar-benar dipakai tree.
+static size_t heapBytes = 0;
+
+void* operator new(size_t size) {
+    void* p = malloc(size);
+    if (!p) throw bad_alloc();
+    heapBytes += malloc_usable_size(p);
+    return p;
+}
+
+void* operator new(size_t size, align_val_t align) {
+    void* p = aligned_alloc((size_t)align, (size + (size_t)align - 1) / (size_t)align * (size_t)align);
+    if (!p) throw bad_alloc();
+    heapBytes += malloc_usable_size(p);
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    heapBytes -= malloc_usable_size(p);
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete(void* p, align_val_t) noexcept { operator delete(p); }
+void operator delete(void* p, size_t, align_val_t) noexcept { operator delete(p); }
+
+// Layout lama (sebelum array inline): dua vector per node dan `new` per split.
+// Hanya insert dan search, cukup untuk pembanding.
+template <int Order>
+class VectorLayoutTree {
+    struct BPlusNode {
+        bool isLeaf;
+        vector<int> keys;
+        vector<BPlusNode*> children;
+        BPlusNode* parent;
+        BPlusNode* next;
+
+        BPlusNode(bool leaf) : isLeaf(leaf), parent(nullptr), next(nullptr) {}
+    };
+
+    BPlusNode* root = nullptr;
+
+    BPlusNode* findLeaf(int key) const {
+        BPlusNode* cursor = root;
+        while (!cursor->isLeaf) {
+            bool found = false;
+            for (int i = 0; i < (int)cursor->keys.size(); i++) {
+                if (key < cursor->keys[i]) {
+                    cursor = cursor->children[i];
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) cursor = cursor->children.back();
+        }
+        return cursor;
+    }
+
+    void insertInternal(int key, BPlusNode* cursor, BPlusNode* child) {
+        auto it = upper_bound(cursor->keys.begin(), cursor->keys.end(), key);
+        int index = it - cursor->keys.begin();
+        cursor->keys.insert(it, key);
+        cursor->children.insert(cursor->children.begin() + index + 1, child);
+
+        if (cursor->keys.size() >= Order) {
+            BPlusNode* newInternal = new BPlusNode(false);
+            int mid = Order / 2;
+            newInternal->keys.assign(cursor->keys.begin() + mid + 1, cursor->keys.end());
+            newInternal->children.assign(cursor->children.begin() + mid + 1, cursor->children.end());
+            int upKey = cursor->keys[mid];
+            cursor->keys.resize(mid);
+            cursor->children.resize(mid + 1);
+            for (auto c : newInternal->children) c->parent = newInternal;
+            split(cursor, upKey, newInternal);
+        }
+    }
+
+    void split(BPlusNode* left, int key, BPlusNode* right) {
+        if (left == root) {
+            root = new BPlusNode(false);
+            root->keys.push_back(key);
+            root->children.push_back(left);
+            root->children.push_back(right);
+            left->parent = root;
+            right->parent = root;
+        } else {
+            right->parent = left->parent;
+            insertInternal(key, left->parent, right);
+        }
+    }
+
+    void destroy(BPlusNode* node) {
+        if (!node->isLeaf) {
+            for (BPlusNode* c : node->children) destroy(c);
+        }
+        delete node;
+    }
+
+public:
+    ~VectorLayoutTree() {
+        if (root) destroy(root);
+    }
+
+    void insert(int key) {
+        if (!root) {
+            root = new BPlusNode(true);
+            root->keys.push_back(key);
+            return;
+        }
+        BPlusNode* cursor = findLeaf(key);
+        auto it = lower_bound(cursor->keys.begin(), cursor->keys.end(), key);
+        if (it != cursor->keys.end() && *it == key) return;
+        cursor->keys.insert(it, key);
+
+        if (cursor->keys.size() >= Order) {
+            BPlusNode* newLeaf = new BPlusNode(true);
+            int mid = (Order + 1) / 2;
+            newLeaf->keys.assign(cursor->keys.begin() + mid, cursor->keys.end());
+            cursor->keys.resize(mid);
+            newLeaf->next = cursor->next;
+            cursor->next = newLeaf;
+            split(cursor, newLeaf->keys[0], newLeaf);
+        }
+    }
+
+    bool search(int key) const {
+        BPlusNode* cursor = findLeaf(key);
+        for (int k : cursor->keys) {
+            if (k == key) return true;
+        }
+        return false;
+    }
+
+    // Sama dengan BPlusTree::memoryStats, ditambah buffer kedua vector per
+    // node; capacity yang tidak terpakai masuk slack.
+    MemoryStats memoryStats() const {
+        MemoryStats m;
+        vector<const BPlusNode*> stack;
+        if (root) stack.push_back(root);
+        while (!stack.empty()) {
+            const BPlusNode* node = stack.back();
+            stack.pop_back();
+            size_t block = heapBlockBytes(node);
+            size_t keyBuf = heapBlockBytes(node->keys.data());
+            size_t childBuf = heapBlockBytes(node->children.data());
+            m.nodes++;
+            m.totalBytes += block + keyBuf + childBuf;
+            m.pointerBytes += sizeof(node->parent) + sizeof(node->next) + childBuf;
+            m.slackBytes += block - sizeof(BPlusNode) + keyBuf - node->keys.size() * sizeof(int);
+            if (node->isLeaf) {
+                m.leaves++;
+                m.keys += node->keys.size();
+                m.keySlots += Order - 1;
+            } else {
+                m.slackBytes += childBuf - node->children.size() * sizeof(BPlusNode*);
+                for (const BPlusNode* c : node->children) stack.push_back(c);
+            }
+        }
+        return m;
+    }
+};
+
+// Build dari key acak, lalu ukur byte per key dan latensi point lookup.
+template <typename Tree>
+void benchLayout(const string& name, const vector<int>& keys, const vector<int>& probes) {
+    size_t before = heapBytes;
+    auto* tree = new Tree();
+    auto startBuild = high_resolution_clock::now();
+    for (int k : keys) tree->insert(k);
+    auto endBuild = high_resolution_clock::now();
+    size_t bytes = heapBytes - before;
+    MemoryStats mem = tree->memoryStats();
+
+    size_t found = 0;
+    auto start = high_resolution_clock::now();
+    for (int k : probes) found += tree->search(k);
+    auto end = high_resolution_clock::now();
+
+    double lookupNs = (double)duration_cast<nanoseconds>(end - start).count() / probes.size();
+    double buildMs = duration_cast<microseconds>(endBuild - startBuild).count() / 1000.0;
+    cout << "  " << left << setw(16) << name << right
+         << setw(10) << (double)bytes / keys.size() << " byte/key"
+         << setw(10) << lookupNs << " ns/lookup"
+         << setw(12) << buildMs << " ms build"
+         << "  (" << found << " ditemukan)\n";
+    cout << "  " << setw(16) << "" << setw(10) << mem.bytesPerKey() << " byte/key terhitung, fill "
+         << mem.fillFactor() << ", pointer " << 100.0 * mem.pointerBytes / mem.totalBytes << "%, slack "
+         << 100.0 * mem.slackBytes / mem.totalBytes << "%\n";
+    delete tree;
+}
+
+// Setara std::less<int>, tapi membuat BPlusTree memakai scan linear generik
+// (jalur sebelum kernel SIMD) sebagai pembanding "sebelum".
+struct LinearLess {
+    bool operator()(int a, int b) const { return a < b; }
+};
+
+template <int Order>
+void benchSearchKernels(const vector<int>& keys, const vector<int>& probes) {
+    BPlusTree<int, BPlusEmpty, Order, LinearLess> linear;
+    BPlusTree<int, BPlusEmpty, Order> simd;
+    for (int k : keys) {
+        linear.insert(k);
+        simd.insert(k);
+    }
+
+    auto measure = [&](const string& name, auto& tree) {
+        size_t found = 0;
+        auto start = high_resolution_clock::now();
+        for (int k : probes) found += tree.search(k);
+        auto end = high_resolution_clock::now();
+        double ns = (double)duration_cast<nanoseconds>(end - start).count() / probes.size();
+        cout << "  O=" << left << setw(4) << Order << setw(16) << name << right
+             << setw(10) << ns << " ns/lookup  (" << found << " ditemukan)\n";
+    };
+
+    SearchKernel best = activeSearchKernel();
+    measure("linear (lama)", linear);
+    for (SearchKernel k : {SearchKernel::Scalar, SearchKernel::Sse42, SearchKernel::Avx2}) {
+        if (k > best) break;
+        useSearchKernel(k);
+        measure(searchKernelName(k), simd);
+    }
+    useSearchKernel(best);
+}
+
+int main(int argc, char* argv[]) {
+    bool searchMode = argc > 1 && string(argv[1]) == "--search";
+    vector<size_t> sizes = {1000000, 10000000};
+    if (argc > (searchMode ? 2 : 1)) {
+        sizes.clear();
+        for (int i = searchMode ? 2 : 1; i < argc; i++) sizes.push_back(strtoull(argv[i], nullptr, 10));
+    }
+
+    if (searchMode) {
+        cout << fixed << setprecision(2);
+        cout << "Kernel aktif: " << searchKernelName(activeSearchKernel()) << "\n";
+        for (size_t n : sizes) {
+            vector<int> keys(n);
+            iota(keys.begin(), keys.end(), 0);
+            mt19937 rng(7);
+            shuffle(keys.begin(), keys.end(), rng);
+            vector<int> probes(1000000);
+            uniform_int_distribution<int> pick(0, (int)n - 1);
+            for (int& p : probes) p = pick(rng);
+
+            cout << "\n" << n << " key int acak, " << probes.size() << " lookup acak\n";
+            benchSearchKernels<16>(keys, probes);
+            benchSearchKernels<64>(keys, probes);
+            benchSearchKernels<128>(keys, probes);
+            benchSearchKernels<256>(keys, probes);
+        }
+        return 0;
+    }
+
+    cout << fixed << setprecision(2);
+    cout << "Ukuran node inline: Order 16 leaf " << BPlusTree<int, BPlusEmpty, 16>::LEAF_BYTES
+         << " B, internal " << BPlusTree<int, BPlusEmpty, 16>::INNER_BYTES << " B; Order 64 leaf "
+         << BPlusTree<int, BPlusEmpty, 64>::LEAF_BYTES << " B, internal "
+         << BPlusTree<int, BPlusEmpty, 64>::INNER_BYTES << " B\n";
+
+    for (size_t n : sizes) {
+        vector<int> keys(n);
+        iota(keys.begin(), keys.end(), 0);
+        mt19937 rng(7);
+        shuffle(keys.begin(), keys.end(), rng);
+
+        vector<int> probes(1000000);
+        uniform_int_distribution<int> pick(0, (int)n - 1);
+        for (int& p : probes) p = pick(rng);
+
+        cout << "\n" << n << " key int acak, " << probes.size() << " lookup acak\n";
+        benchLayout<VectorLayoutTree<4>>("vector O=4", keys, probes);
+        benchLayout<BPlusTree<int, BPlusEmpty, 4>>("inline O=4", keys, probes);
+        benchLayout<VectorLayoutTree<16>>("vector O=16", keys, probes);
+        benchLayout<BPlusTree<int, BPlusEmpty, 16>>("inline O=16", keys, probes);
+        benchLayout<VectorLayoutTree<64>>("vector O=64", keys, probes);
+        benchLayout<BPlusTree<int, BPlusEmpty, 64>>("inline O=64", keys, probes);
+    }
+    return 0;
+}
@@ -0,0 +1,241 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <memory>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+#include "bplus_tree.h"
+#include "bplus_concurrent.h"
+#include "hashtable_open.h"
+#include "hashtable_concurrent.h"
+#include "bench_util.h"
+
+using namespace std;
+
+// Benchmark throughput multi-thread: setiap engine dijalankan dengan 1..N
+// thread pada workload yang sama, lalu dilaporkan Mops/s total dan speedup
+// terhadap 1 thread. Versi konkuren dibandingkan dengan struktur biasa di
+// belakang satu reader-writer lock.
+
+const int ORDER = 64;
+
+struct OlcTreeEngine {
+    ConcurrentBPlusTree<int, BPlusEmpty, ORDER> tree;
+
+    static string name() { return "bplus-olc"; }
+    bool find(int k) { return tree.search(k); }
+    bool insert(int k) { return tree.insert(k); }
+    bool erase(int k) { return tree.remove(k); }
+};
+
+struct LockedTreeEngine {
+    BPlusTree<int, BPlusEmpty, ORDER> tree;
+    shared_mutex mutex;
+
+    static string name() { return "bplus-rwlock"; }
+    bool find(int k) {
+        shared_lock<shared_mutex> lock(mutex);
+        return tree.search(k);
+    }
+    bool insert(int k) {
+        unique_lock<shared_mutex> lock(mutex);
+        return tree.insert(k);
+    }
+    bool erase(int k) {
+        unique_lock<shared_mutex> lock(mutex);
+        return tree.remove(k);
+    }
+};
+
+struct ConcurrentHashEngine {
+    ConcurrentHashTable<int> table;
+
+    static string name() { return "hash-epoch"; }
+    bool find(int k) { return table.search(k); }
+    bool insert(int k) { return table.insert(k); }
+    bool erase(int k) { return table.remove(k); }
+};
+
+struct LockedHashEngine {
+    OpenHashTable<int> table;
+    shared_mutex mutex;
+
+    static string name() { return "hash-rwlock"; }
+    bool find(int k) {
+        shared_lock<shared_mutex> lock(mutex);
+        int it;
+        return table.search(k, it);
+    }
+    bool insert(int k) {
+        unique_lock<shared_mutex> lock(mutex);
+        return table.insert(k);
+    }
+    bool erase(int k) {
+        unique_lock<shared_mutex> lock(mutex);
+        int it;
+        return table.remove(k, it);
+    }
+};
+
+enum OpType { OP_FIND, OP_INSERT, OP_ERASE };
+
+struct Op {
+    OpType type;
+    int key;
+};
+
+struct Workload {
+    string name;
+    double insertRatio;
+    double eraseRatio;
+};
+
+const Workload WORKLOADS[] = {
+    {"read-only", 0.0, 0.0},
+    {"read-90", 0.05, 0.05},
+    {"write-50", 0.25, 0.25},
+    // Jumlah key bertambah selama run, jadi hash table di-resize sambil dibaca.
+    {"grow-50", 0.5, 0.0},
+};
+
+// Key awal adalah bilangan genap 0..2n. Setiap thread menyisipkan key ganjil
+// dari rentangnya sendiri dan hanya menghapus key yang ia sisipkan, jadi
+// hasil setiap operasi bisa diperiksa.
+vector<Op> makeOps(const Workload& w, size_t n, size_t count, int tid, int threads) {
+    mt19937_64 rng(1000 + tid);
+    uniform_int_distribution<size_t> pick(0, n - 1);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    vector<Op> ops;
+    ops.reserve(count);
+    vector<int> mine;
+    size_t fresh = tid;
+    for (size_t i = 0; i < count; i++) {
+        double u = unit(rng);
+        if (u < w.insertRatio) {
+            int key = (int)(2 * (n + fresh) + 1);
+            fresh += threads;
+            ops.push_back({OP_INSERT, key});
+            mine.push_back(key);
+        } else if (u < w.insertRatio + w.eraseRatio && !mine.empty()) {
+            size_t idx = uniform_int_distribution<size_t>(0, mine.size() - 1)(rng);
+            ops.push_back({OP_ERASE, mine[idx]});
+            mine[idx] = mine.back();
+            mine.pop_back();
+        } else {
+            ops.push_back({OP_FIND, (int)(2 * pick(rng))});
+        }
+    }
+    return ops;
+}
+
+template <typename Engine>
+void runEngine(size_t n, size_t opsPerThread, const vector<int>& threadCounts) {
+    for (const Workload& w : WORKLOADS) {
+        double base = 0;
+        for (int threads : threadCounts) {
+            // Struktur baru per run supaya sisa insert run sebelumnya tidak ikut.
+            unique_ptr<Engine> engine(new Engine());
+            for (size_t i = 0; i < n; i++) engine->insert((int)(2 * i));
+
+            vector<vector<Op>> ops(threads);
+            for (int t = 0; t < threads; t++) ops[t] = makeOps(w, n, opsPerThread, t, threads);
+
+            atomic<int> ready(0);
+            atomic<bool> go(false);
+            atomic<size_t> failures(0);
+            vector<thread> workers;
+            for (int t = 0; t < threads; t++) {
+                workers.emplace_back([&, t]() {
+                    ready++;
+                    while (!go.load(memory_order_acquire)) this_thread::yield();
+                    size_t bad = 0;
+                    for (const Op& op : ops[t]) {
+                        switch (op.type) {
+                            case OP_FIND: bad += !engine->find(op.key); break;
+                            case OP_INSERT: engine->insert(op.key); break;
+                            case OP_ERASE: bad += !engine->erase(op.key); break;
+                        }
+                    }
+                    failures += bad;
+                });
+            }
+            while (ready.load() < threads) this_thread::yield();
+            uint64_t start = nowNs();
+            go.store(true, memory_order_release);
+            for (thread& th : workers) th.join();
+            uint64_t elapsed = nowNs() - start;
+
+            double mops = (double)threads * opsPerThread * 1000.0 / elapsed;
+            if (threads == threadCounts.front()) base = mops;
+            cout << left << setw(14) << Engine::name() << setw(11) << w.name << right << setw(8) << threads
+                 << setw(11) << fixed << setprecision(2) << mops << setw(9) << mops / base << "x";
+            if (failures) cout << "  (" << failures << " operasi gagal!)";
+            cout << "\n";
+        }
+    }
+}
+
+vector<int> defaultThreads() {
+    int maxThreads = max(1u, thread::hardware_concurrency());
+    vector<int> counts;
+    for (int t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+    counts.push_back(maxThreads);
+    return counts;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = 1000000;
+    size_t ops = 1000000;
+    vector<int> threadCounts = defaultThreads();
+    vector<string> engines = {"bplus-olc", "bplus-rwlock", "hash-epoch", "hash-rwlock"};
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string arg = argv[i];
+        string value = argv[i + 1];
+        if (arg == "--n") {
+            n = strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--ops") {
+            ops = strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--threads") {
+            threadCounts.clear();
+            stringstream ss(value);
+            string item;
+            while (getline(ss, item, ',')) threadCounts.push_back(atoi(item.c_str()));
+        } else if (arg == "--engines") {
+            engines.clear();
+            stringstream ss(value);
+            string item;
+            while (getline(ss, item, ',')) engines.push_back(item);
+        } else {
+            cerr << "Usage: " << argv[0] << " [--n N] [--ops per-thread] [--threads 1,2,4,...] "
+                 << "[--engines bplus-olc,bplus-rwlock,hash-epoch,hash-rwlock]\n";
+            return 1;
+        }
+    }
+
+    cout << n << " key awal, " << ops << " operasi per thread, " << thread::hardware_concurrency()
+         << " core terdeteksi\n\n";
+    cout << left << setw(14) << "engine" << setw(11) << "workload" << right << setw(8) << "thread"
+         << setw(11) << "Mops/s" << setw(10) << "speedup" << "\n";
+    for (const string& e : engines) {
+        if (e == OlcTreeEngine::name()) {
+            runEngine<OlcTreeEngine>(n, ops, threadCounts);
+        } else if (e == LockedTreeEngine::name()) {
+            runEngine<LockedTreeEngine>(n, ops, threadCounts);
+        } else if (e == ConcurrentHashEngine::name()) {
+            runEngine<ConcurrentHashEngine>(n, ops, threadCounts);
+        } else if (e == LockedHashEngine::name()) {
+            runEngine<LockedHashEngine>(n, ops, threadCounts);
+        } else {
+            cerr << "Engine tidak dikenal: " << e << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+#include <cstdint>
+#include "hashtable_open.h"
+#include "hashtable_incremental.h"
+#include "bench_util.h"
+
+using namespace std;
+
+// Latensi insert per operasi saat tabel tumbuh dari kosong. Setiap insert
+// diukur sendiri-sendiri; sampel dipotong per segmen di antara dua resize,
+// jadi terlihat apakah p999 dan max melonjak di sekitar batas resize.
+// Pembanding: OpenHashTable dan IncrementalHashTable dengan step 0
+// (rehash stop-the-world) melawan migrasi bertahap beberapa bucket per operasi.
+
+struct Segment {
+    size_t firstInsert;
+    size_t buckets;
+    LatencyStats latency;
+};
+
+template <typename Table, typename CapacityFn>
+void runInserts(const string& name, Table& table, CapacityFn capacity, const vector<uint64_t>& keys,
+                size_t minSegment, uint64_t overhead) {
+    LatencyStats all;
+    all.reserve(keys.size());
+    vector<Segment> segments;
+    segments.push_back(Segment{0, capacity(table), LatencyStats()});
+    size_t resizeInserts = 0;
+    uint64_t resizeWorst = 0;
+
+    for (size_t i = 0; i < keys.size(); i++) {
+        size_t before = capacity(table);
+        uint64_t start = nowNs();
+        table.insert(keys[i]);
+        uint64_t ns = nowNs() - start;
+        ns = ns > overhead ? ns - overhead : 0;
+        all.add(ns);
+        segments.back().latency.add(ns);
+        if (capacity(table) != before) {
+            resizeInserts++;
+            resizeWorst = max(resizeWorst, ns);
+            segments.push_back(Segment{i + 1, capacity(table), LatencyStats()});
+        }
+    }
+
+    cout << "\n" << name << ": " << resizeInserts << " resize, insert pemicu terburuk " << resizeWorst / 1000.0
+         << " us\n";
+    cout << "  " << left << setw(12) << "mulai" << right << setw(12) << "bucket" << setw(10) << "p50" << setw(10)
+         << "p99" << setw(10) << "p999" << setw(12) << "max" << "\n";
+    for (Segment& s : segments) {
+        if (s.latency.count() < minSegment) continue;
+        cout << "  " << left << setw(12) << s.firstInsert << right << setw(12) << s.buckets << setw(10)
+             << s.latency.percentile(0.5) << setw(10) << s.latency.percentile(0.99) << setw(10)
+             << s.latency.percentile(0.999) << setw(12) << s.latency.max() << "\n";
+    }
+    cout << "  " << left << setw(12) << "total" << right << setw(12) << capacity(table) << setw(10)
+         << all.percentile(0.5) << setw(10) << all.percentile(0.99) << setw(10) << all.percentile(0.999)
+         << setw(12) << all.max() << "  (ns)\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = 4000000;
+    size_t minSegment = 10000;
+    vector<size_t> steps = {0, 1, 8, 64};
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string arg = argv[i];
+        string value = argv[i + 1];
+        if (arg == "--n") {
+            n = strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--min-segment") {
+            minSegment = strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--steps") {
+            steps.clear();
+            stringstream ss(value);
+            string item;
+            while (getline(ss, item, ',')) steps.push_back(strtoull(item.c_str(), nullptr, 10));
+        } else {
+            cerr << "Usage: " << argv[0] << " [--n N] [--steps 0,1,8,64] [--min-segment M]\n";
+            return 1;
+        }
+    }
+
+    vector<uint64_t> keys(n);
+    mt19937_64 rng(7);
+    for (uint64_t& k : keys) k = rng();
+    uint64_t overhead = timerOverheadNs();
+
+    cout << fixed << setprecision(1);
+    cout << n << " insert key uint64 acak ke tabel kosong, overhead timer " << overhead
+         << " ns dikurangkan; segmen < " << minSegment << " insert tidak ditampilkan\n";
+
+    {
+        OpenHashTable<uint64_t> table(16);
+        runInserts("open addressing (rehash penuh)", table,
+                   [](const OpenHashTable<uint64_t>& t) { return t.capacity(); }, keys, minSegment, overhead);
+    }
+    for (size_t step : steps) {
+        IncrementalHashTable<uint64_t> table(16, 1.0, step);
+        string name = step == 0 ? "chaining, rehash penuh (step 0)"
+                                : "chaining, migrasi bertahap (step " + to_string(step) + ")";
+        runInserts(name, table, [](const IncrementalHashTable<uint64_t>& t) { return t.bucketCount(); }, keys,
+                   minSegment, overhead);
+    }
+    return 0;
+}
@@ -0,0 +1,232 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "data_loader.h"
+#include "hash_function.h"
+
+// Alat bantu benchmark: timer nanodetik, statistik persentil, generator
+// Zipfian, penulis hasil CSV/JSON, dan driver --parallel. Dipakai oleh
+// benchmark.cpp, program bench_*.cpp, bplus_int, dan hashtable_int_2.
+
+typedef std::chrono::steady_clock BenchClock;
+
+inline uint64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               BenchClock::now().time_since_epoch()).count();
+}
+
+// Biaya minimum satu pasang pembacaan timer; dikurangkan dari setiap sampel.
+inline uint64_t timerOverheadNs() {
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < 10000; i++) {
+        uint64_t a = nowNs();
+        uint64_t b = nowNs();
+        best = std::min(best, b - a);
+    }
+    return best;
+}
+
+// Kumpulan sampel latensi per operasi.
+class LatencyStats {
+public:
+    void reserve(size_t n) { samples_.reserve(n); }
+    void add(uint64_t ns) { samples_.push_back(ns); }
+    size_t count() const { return samples_.size(); }
+
+    // p dalam [0, 1], misal 0.999 untuk p999.
+    uint64_t percentile(double p) {
+        if (samples_.empty()) return 0;
+        sortOnce();
+        size_t idx = std::min(samples_.size() - 1, (size_t)std::ceil(p * samples_.size()) - (p > 0 ? 1 : 0));
+        return samples_[idx];
+    }
+
+    uint64_t max() {
+        if (samples_.empty()) return 0;
+        sortOnce();
+        return samples_.back();
+    }
+
+private:
+    std::vector<uint64_t> samples_;
+    bool sorted_ = false;
+
+    void sortOnce() {
+        if (!sorted_) std::sort(samples_.begin(), samples_.end());
+        sorted_ = true;
+    }
+};
+
+// Zipfian (YCSB) atas rank [0, n). Rank kemudian diacak dengan hash supaya
+// key yang "panas" tidak berkumpul di satu ujung ruang key.
+class ZipfGenerator {
+public:
+    ZipfGenerator(uint64_t n, double theta = 0.99) : n_(n), theta_(theta) {
+        for (uint64_t i = 1; i <= n; i++) zetan_ += 1.0 / std::pow((double)i, theta);
+        double zeta2 = 1.0 + 1.0 / std::pow(2.0, theta);
+        alpha_ = 1.0 / (1.0 - theta);
+        eta_ = (1.0 - std::pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta2 / zetan_);
+    }
+
+    // u seragam di [0, 1).
+    uint64_t rank(double u) const {
+        double uz = u * zetan_;
+        if (uz < 1.0) return 0;
+        if (uz < 1.0 + std::pow(0.5, theta_)) return 1;
+        uint64_t r = (uint64_t)(n_ * std::pow(eta_ * u - eta_ + 1.0, alpha_));
+        return std::min(r, n_ - 1);
+    }
+
+    uint64_t scrambled(double u) const { return mix64(rank(u)) % n_; }
+
+private:
+    uint64_t n_;
+    double theta_;
+    double zetan_ = 0;
+    double alpha_ = 0;
+    double eta_ = 0;
+};
+
+struct BenchRow {
+    std::string engine;
+    std::string workload;
+    std::string keyType;
+    size_t n;
+    size_t ops;
+    int reps;
+    double meanNs;
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t p999;
+    uint64_t maxNs;
+    double mopsPerSec;
+    double bytesPerKey;  // footprint struktur sesudah workload, dari memoryStats()
+};
+
+inline bool writeCsv(const char* path, const std::vector<BenchRow>& rows) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "engine,workload,key_type,n,ops,reps,mean_ns,p50_ns,p99_ns,p999_ns,max_ns,mops,bytes_per_key\n");
+    for (const BenchRow& r : rows) {
+        fprintf(f, "%s,%s,%s,%zu,%zu,%d,%.2f,%llu,%llu,%llu,%llu,%.3f,%.2f\n", r.engine.c_str(),
+                r.workload.c_str(), r.keyType.c_str(), r.n, r.ops, r.reps, r.meanNs,
+                (unsigned long long)r.p50, (unsigned long long)r.p99, (unsigned long long)r.p999,
+                (unsigned long long)r.maxNs, r.mopsPerSec, r.bytesPerKey);
+    }
+    return fclose(f) == 0;
+}
+
+inline bool writeJson(const char* path, const std::vector<BenchRow>& rows) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "[\n");
+    for (size_t i = 0; i < rows.size(); i++) {
+        const BenchRow& r = rows[i];
+        fprintf(f,
+                "  {\"engine\": \"%s\", \"workload\": \"%s\", \"key_type\": \"%s\", \"n\": %zu, "
+                "\"ops\": %zu, \"reps\": %d, \"mean_ns\": %.2f, \"p50_ns\": %llu, \"p99_ns\": %llu, "
+                "\"p999_ns\": %llu, \"max_ns\": %llu, \"mops\": %.3f, \"bytes_per_key\": %.2f}%s\n",
+                r.engine.c_str(), r.workload.c_str(), r.keyType.c_str(), r.n, r.ops, r.reps, r.meanNs,
+                (unsigned long long)r.p50, (unsigned long long)r.p99, (unsigned long long)r.p999,
+                (unsigned long long)r.maxNs, r.mopsPerSec, r.bytesPerKey, i + 1 < rows.size() ? "," : "");
+    }
+    fprintf(f, "]\n");
+    return fclose(f) == 0;
+}
+
+// Batas atas argumen jumlah thread program benchmark.
+const unsigned MAX_BENCH_THREADS = 1024;
+
+// Jumlah thread dari argumen baris perintah: bilangan bulat
+// 1..MAX_BENCH_THREADS tanpa karakter sisa. arg nullptr berarti semua core
+// yang terdeteksi. Mengembalikan false kalau argumen tidak valid.
+inline bool parseThreadCount(const char* arg, unsigned& threads) {
+    if (!arg) {
+        threads = std::max(1u, std::min(MAX_BENCH_THREADS, std::thread::hardware_concurrency()));
+        return true;
+    }
+    char* end;
+    long n = strtol(arg, &end, 10);
+    if (end == arg || *end != '\0' || n < 1 || n > (long)MAX_BENCH_THREADS) return false;
+    threads = (unsigned)n;
+    return true;
+}
+
+// Satu cara membangun struktur dari semua key; mengembalikan jumlah key unik.
+struct BuildStep {
+    std::string name;
+    std::function<size_t(const std::vector<int>&)> run;
+};
+
+// Driver --parallel bersama: ambil key dari file (atau n key acak kalau
+// argumen bukan file), jalankan setiap langkah serial (yang pertama menjadi
+// baseline speedup), lalu build(keys, t) untuk t = 1, 2, 4, ... sampai
+// maxThreads (1..MAX_BENCH_THREADS, lihat parseThreadCount).
+template <typename Build>
+int parallelBuildBench(const char* source, unsigned maxThreads, const std::vector<BuildStep>& serial, Build build) {
+    using namespace std::chrono;
+    if (maxThreads < 1 || maxThreads > MAX_BENCH_THREADS) {
+        std::cerr << "Jumlah thread harus 1.." << MAX_BENCH_THREADS << ": " << maxThreads << std::endl;
+        return 1;
+    }
+    std::vector<int> keys;
+    DataFile file;
+    auto startLoad = steady_clock::now();
+    if (file.open(source)) {
+        size_t loaded = parseInts(file.text(), [&](int key) { keys.push_back(key); });
+        printLoadStats(source, file.bytes(), loaded, steady_clock::now() - startLoad);
+    } else {
+        char* end;
+        long long n = strtoll(source, &end, 10);
+        if (end == source || *end != '\0' || n < 1 || n > INT_MAX) {
+            std::cerr << "Bukan file atau jumlah key (1.." << INT_MAX << "): " << source << std::endl;
+            return 1;
+        }
+        keys.resize(n);
+        std::mt19937 rng(42);
+        for (int& k : keys) k = rng() & 0x7fffffff;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    double base = 0;
+    auto run = [&](const std::string& name, const std::function<size_t()>& fn) {
+        auto start = steady_clock::now();
+        size_t size = fn();
+        double ms = duration_cast<microseconds>(steady_clock::now() - start).count() / 1000.0;
+        if (base == 0) base = ms;
+        std::cout << std::left << std::setw(22) << name << std::right << std::setw(10) << ms << " ms"
+                  << std::setw(9) << keys.size() / ms / 1000.0 << " Mkey/s" << std::setw(7) << base / ms
+                  << "x, " << size << " key unik\n";
+    };
+
+    std::cout << keys.size() << " key, " << std::thread::hardware_concurrency() << " core terdeteksi\n";
+    for (const BuildStep& step : serial) run(step.name, [&] { return step.run(keys); });
+    std::vector<unsigned> counts;
+    // Berhenti sebelum t * 2 bisa overflow.
+    for (unsigned t = 1; t < maxThreads; t *= 2) {
+        counts.push_back(t);
+        if (t > maxThreads / 2) break;
+    }
+    counts.push_back(maxThreads);
+    for (unsigned t : counts) {
+        run("buildParallel " + std::to_string(t) + " thread", [&] { return build(keys, t); });
+    }
+    return 0;
+}
+
+#endif
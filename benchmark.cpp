@@ -0,0 +1,606 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <memory>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+#include <type_traits>
+#include "hashtable_open.h"
+#include "cuckoo_filter.h"
+#include "bplus_tree.h"
+#include "bench_util.h"
+
+using namespace std;
+
+// Driver benchmark bersama untuk hash table dan B+ tree: semua engine
+// menjalankan workload yang sama (key, urutan operasi, dan seed identik),
+// dengan warm-up, beberapa repetisi, timing nanodetik per operasi, dan
+// persentil p50/p99/p999. Hasil bisa ditulis ke CSV/JSON.
+
+// Hasil operasi dikumpulkan di sini supaya tidak dioptimasi hilang.
+volatile size_t benchSink = 0;
+
+enum OpType { OP_FIND, OP_INSERT, OP_ERASE, OP_UPDATE };
+
+template <typename Key>
+struct Op {
+    OpType type;
+    Key key;
+    Key other;  // key baru untuk OP_UPDATE
+};
+
+// Key dibangkitkan dari id angka. Id genap dimuat saat build, id ganjil
+// tidak pernah ada (untuk workload miss).
+template <typename Key>
+Key makeKey(uint64_t id);
+
+template <>
+int makeKey<int>(uint64_t id) { return (int)id; }
+
+template <>
+string makeKey<string>(uint64_t id) { return "user" + to_string(id); }
+
+// Baseline seluruh seri: tabel chaining 26 bucket tetap seperti
+// hashtable_int_2 (key % 26) dan hashtable_string_2 (hashString % 26, hash
+// di-cache di node). Chain tumbuh n / 26, jadi engine ini dilewati untuk n
+// di atas --chain-max.
+template <typename Key>
+struct ChainedHashEngine {
+    static const int TABLE_SIZE = 26;
+
+    struct Node {
+        Key key;
+        uint64_t hash;
+        Node* next;
+    };
+    Node* table[TABLE_SIZE] = {};
+
+    ChainedHashEngine() = default;
+    ChainedHashEngine(const ChainedHashEngine&) = delete;
+    ChainedHashEngine& operator=(const ChainedHashEngine&) = delete;
+
+    ~ChainedHashEngine() {
+        for (Node* head : table) {
+            while (head) {
+                Node* next = head->next;
+                delete head;
+                head = next;
+            }
+        }
+    }
+
+    static string name() { return "hash-chain"; }
+
+    static uint64_t hashOf(const Key& k) {
+        if constexpr (is_same<Key, string>::value) {
+            return hashString(k);
+        } else {
+            return (uint64_t)k;
+        }
+    }
+
+    // Link yang menunjuk node berisi k, atau link kosong di ujung chain.
+    Node** locate(const Key& k, uint64_t hash) {
+        Node** link = &table[hash % TABLE_SIZE];
+        while (*link && !((*link)->hash == hash && (*link)->key == k)) link = &(*link)->next;
+        return link;
+    }
+
+    bool find(const Key& k) { return *locate(k, hashOf(k)) != nullptr; }
+
+    bool insert(const Key& k) {
+        uint64_t hash = hashOf(k);
+        if (*locate(k, hash)) return false;
+        Node*& head = table[hash % TABLE_SIZE];
+        head = new Node{k, hash, head};
+        return true;
+    }
+
+    bool erase(const Key& k) {
+        Node** link = locate(k, hashOf(k));
+        Node* curr = *link;
+        if (!curr) return false;
+        *link = curr->next;
+        delete curr;
+        return true;
+    }
+
+    // Seperti update di kedua program: node lama dipakai ulang dan dipindah
+    // ke kepala bucket key baru.
+    bool update(const Key& a, const Key& b) {
+        uint64_t hash = hashOf(b);
+        if (*locate(b, hash)) return false;
+        Node** link = locate(a, hashOf(a));
+        Node* curr = *link;
+        if (!curr) return false;
+        *link = curr->next;
+        curr->key = b;
+        curr->hash = hash;
+        curr->next = table[hash % TABLE_SIZE];
+        table[hash % TABLE_SIZE] = curr;
+        return true;
+    }
+
+    void findBatch(const Key* keys, size_t n, bool* found) {
+        for (size_t i = 0; i < n; i++) found[i] = find(keys[i]);
+    }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Node* head : table) {
+            for (const Node* curr = head; curr; curr = curr->next) fn(curr->key);
+        }
+    }
+
+    MemoryStats memoryStats() const { return chainedTableStats(table, TABLE_SIZE); }
+};
+
+template <typename Key>
+struct OpenHashEngine {
+    OpenHashTable<Key> table;
+
+    static string name() { return "hash-open"; }
+    bool find(const Key& k) { int it; return table.search(k, it); }
+    bool insert(const Key& k) { return table.insert(k); }
+    bool erase(const Key& k) { int it; return table.remove(k, it); }
+    bool update(const Key& a, const Key& b) { int it; return table.update(a, b, it); }
+    void findBatch(const Key* keys, size_t n, bool* found) const { table.searchBatch(keys, n, found); }
+    template <typename Fn>
+    void forEach(Fn&& fn) const { table.forEach(fn); }
+    MemoryStats memoryStats() const { return table.memoryStats(); }
+};
+
+template <typename Key, int Order, bool Lazy = false>
+struct BPlusEngine {
+    BPlusTree<Key, BPlusEmpty, Order> tree;
+
+    BPlusEngine() {
+        if (Lazy) tree.setDeleteMode(BPlusDeleteMode::Lazy);
+    }
+
+    static string name() { return "bplus-" + to_string(Order) + (Lazy ? "-lazy" : ""); }
+    bool find(const Key& k) { return tree.search(k); }
+    bool insert(const Key& k) { return tree.insert(k); }
+    bool erase(const Key& k) { return tree.remove(k); }
+    bool update(const Key& a, const Key& b) { return tree.update(a, b); }
+    void findBatch(const Key* keys, size_t n, bool* found) const { tree.searchBatch(keys, n, found); }
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (auto it = tree.begin(); it != tree.end(); ++it) fn(it.key());
+    }
+    MemoryStats memoryStats() const { return tree.memoryStats(); }
+};
+
+// Engine lain dengan cuckoo filter di depannya: find yang ditolak filter
+// tidak menyentuh struktur sama sekali. Filter diperbarui setiap insert,
+// erase, dan update yang berhasil; kalau penuh (atau load > 90%) filter
+// dibangun ulang 2x lebih besar dari isi struktur.
+template <typename Engine, typename Key>
+struct FilteredEngine {
+    Engine inner;
+    CuckooFilter filter;
+    KeyHash<Key> hash;
+    size_t rejected = 0;        // miss yang ditolak filter
+    size_t falsePositives = 0;  // lolos filter tapi tidak ada di struktur
+
+    static string name() { return Engine::name() + "+cf"; }
+
+    bool find(const Key& k) {
+        if (!filter.mayContain(hash(k))) {
+            rejected++;
+            return false;
+        }
+        bool found = inner.find(k);
+        falsePositives += !found;
+        return found;
+    }
+
+    bool insert(const Key& k) {
+        if (!inner.insert(k)) return false;
+        add(k);
+        return true;
+    }
+
+    bool erase(const Key& k) {
+        if (!inner.erase(k)) return false;
+        filter.remove(hash(k));
+        return true;
+    }
+
+    bool update(const Key& a, const Key& b) {
+        if (!inner.update(a, b)) return false;
+        filter.remove(hash(a));
+        add(b);
+        return true;
+    }
+
+    // Hanya key yang lolos filter yang dikirim ke searchBatch struktur.
+    vector<Key> maybe;
+    vector<size_t> where;
+    vector<char> hits;
+
+    void findBatch(const Key* keys, size_t n, bool* found) {
+        maybe.clear();
+        where.clear();
+        for (size_t i = 0; i < n; i++) {
+            found[i] = false;
+            if (filter.mayContain(hash(keys[i]))) {
+                maybe.push_back(keys[i]);
+                where.push_back(i);
+            } else {
+                rejected++;
+            }
+        }
+        hits.resize(maybe.size() + 1);
+        inner.findBatch(maybe.data(), maybe.size(), reinterpret_cast<bool*>(hits.data()));
+        for (size_t i = 0; i < maybe.size(); i++) {
+            found[where[i]] = hits[i];
+            falsePositives += !hits[i];
+        }
+    }
+
+    MemoryStats memoryStats() const {
+        MemoryStats m = inner.memoryStats();
+        m.totalBytes += filter.bytes();
+        return m;
+    }
+
+    // Kalau add gagal, key belum tercatat; rebuild menambahkannya lagi dari
+    // struktur, jadi find tidak pernah false negative.
+    void add(const Key& k) {
+        if (filter.add(hash(k)) && !filter.full() && filter.loadFactor() <= 0.9) return;
+        bool recorded;
+        do {
+            // reset(capacity) menggandakan jumlah bucket.
+            filter.reset(filter.capacity());
+            recorded = true;
+            inner.forEach([&](const Key& key) { recorded &= filter.add(hash(key)); });
+        } while (!recorded || filter.full());
+    }
+};
+
+struct Config {
+    vector<size_t> sizes = {1000, 100000, 1000000};
+    vector<string> engines = {"hash-chain", "hash-open", "bplus"};
+    vector<string> workloads = {"uniform", "batch", "zipf", "sequential", "miss-heavy", "mix-rw", "mix-update"};
+    size_t batch = 256;
+    size_t chainMax = 10000;  // n terbesar untuk engine hash-chain
+    size_t ops = 1000000;
+    int reps = 5;
+    int warmup = 1;
+    string keyType = "int";
+    string csvPath;
+    string jsonPath;
+};
+
+// State key yang sedang ada di struktur, disimulasikan saat membangkitkan
+// operasi supaya setiap operasi mutasi valid.
+struct KeySpace {
+    vector<uint64_t> live;
+    uint64_t nextFresh;
+    mt19937_64 rng;
+    unique_ptr<ZipfGenerator> zipf;
+
+    KeySpace(size_t n) : nextFresh(2 * (uint64_t)n), rng(12345) {
+        live.resize(n);
+        for (size_t i = 0; i < n; i++) live[i] = 2 * (uint64_t)i;
+    }
+
+    size_t pick() { return uniform_int_distribution<size_t>(0, live.size() - 1)(rng); }
+    double unit() { return uniform_real_distribution<double>(0.0, 1.0)(rng); }
+};
+
+template <typename Key>
+vector<Op<Key>> generate(const string& workload, KeySpace& ks, size_t count) {
+    vector<Op<Key>> ops;
+    ops.reserve(count);
+    if (workload == "uniform" || workload == "batch") {
+        for (size_t i = 0; i < count; i++) ops.push_back({OP_FIND, makeKey<Key>(ks.live[ks.pick()]), Key()});
+    } else if (workload == "zipf") {
+        if (!ks.zipf) ks.zipf.reset(new ZipfGenerator(ks.live.size()));
+        for (size_t i = 0; i < count; i++) {
+            uint64_t idx = ks.zipf->scrambled(ks.unit()) % ks.live.size();
+            ops.push_back({OP_FIND, makeKey<Key>(ks.live[idx]), Key()});
+        }
+    } else if (workload == "sequential") {
+        vector<uint64_t> sorted = ks.live;
+        sort(sorted.begin(), sorted.end());
+        size_t start = ks.pick();
+        for (size_t i = 0; i < count; i++) {
+            ops.push_back({OP_FIND, makeKey<Key>(sorted[(start + i) % sorted.size()]), Key()});
+        }
+    } else if (workload == "miss") {
+        // Semua key tidak ada: latensi jalur miss murni.
+        for (size_t i = 0; i < count; i++) ops.push_back({OP_FIND, makeKey<Key>(2 * (uint64_t)ks.pick() + 1), Key()});
+    } else if (workload == "miss-heavy") {
+        // 90% key yang tidak ada (id ganjil), 10% hit.
+        for (size_t i = 0; i < count; i++) {
+            uint64_t id = ks.unit() < 0.9 ? 2 * (uint64_t)ks.pick() + 1 : ks.live[ks.pick()];
+            ops.push_back({OP_FIND, makeKey<Key>(id), Key()});
+        }
+    } else if (workload == "mix-rw") {
+        // 50% find, 25% insert key baru, 25% delete key acak; jumlah key tetap.
+        vector<OpType> types(count, OP_FIND);
+        for (size_t i = 0; i < count / 4; i++) {
+            types[i] = OP_INSERT;
+            types[count / 4 + i] = OP_ERASE;
+        }
+        shuffle(types.begin(), types.end(), ks.rng);
+        for (OpType t : types) {
+            if (t == OP_INSERT) {
+                ks.live.push_back(ks.nextFresh);
+                ops.push_back({OP_INSERT, makeKey<Key>(ks.nextFresh), Key()});
+                ks.nextFresh += 2;
+            } else if (t == OP_ERASE && ks.live.size() > 1) {
+                size_t idx = ks.pick();
+                ops.push_back({OP_ERASE, makeKey<Key>(ks.live[idx]), Key()});
+                ks.live[idx] = ks.live.back();
+                ks.live.pop_back();
+            } else {
+                ops.push_back({OP_FIND, makeKey<Key>(ks.live[ks.pick()]), Key()});
+            }
+        }
+    } else if (workload == "mix-update") {
+        // 50% find, 50% update key acak menjadi key baru.
+        for (size_t i = 0; i < count; i++) {
+            size_t idx = ks.pick();
+            if (ks.unit() < 0.5) {
+                ops.push_back({OP_FIND, makeKey<Key>(ks.live[idx]), Key()});
+            } else {
+                ops.push_back({OP_UPDATE, makeKey<Key>(ks.live[idx]), makeKey<Key>(ks.nextFresh)});
+                ks.live[idx] = ks.nextFresh;
+                ks.nextFresh += 2;
+            }
+        }
+    }
+    return ops;
+}
+
+template <typename Engine, typename Key>
+bool apply(Engine& e, const Op<Key>& op) {
+    switch (op.type) {
+        case OP_FIND: return e.find(op.key);
+        case OP_INSERT: return e.insert(op.key);
+        case OP_ERASE: return e.erase(op.key);
+        default: return e.update(op.key, op.other);
+    }
+}
+
+BenchRow makeRow(const string& engine, const string& workload, const Config& cfg, size_t n,
+                 size_t ops, int reps, LatencyStats& stats, uint64_t totalNs) {
+    BenchRow row;
+    row.engine = engine;
+    row.workload = workload;
+    row.keyType = cfg.keyType;
+    row.n = n;
+    row.ops = ops;
+    row.reps = reps;
+    row.meanNs = stats.count() ? (double)totalNs / stats.count() : 0;
+    row.p50 = stats.percentile(0.50);
+    row.p99 = stats.percentile(0.99);
+    row.p999 = stats.percentile(0.999);
+    row.maxNs = stats.max();
+    row.mopsPerSec = row.meanNs > 0 ? 1000.0 / row.meanNs : 0;
+    row.bytesPerKey = 0;
+    return row;
+}
+
+// Hanya FilteredEngine punya filter; engine lain tidak mencetak apa-apa.
+template <typename Engine>
+void printFilterStats(Engine&, long) {}
+
+template <typename Engine>
+auto printFilterStats(Engine& e, int) -> decltype(e.filter, void()) {
+    size_t misses = e.rejected + e.falsePositives;
+    if (misses > 0) {
+        cout << "  filter: " << setprecision(1) << 8.0 * e.filter.bytes() / max<size_t>(1, e.filter.size())
+             << " bit/key, load " << setprecision(2) << e.filter.loadFactor() << ", " << misses
+             << " miss, FPR " << setprecision(4) << 100.0 * e.falsePositives / misses << "%\n";
+    }
+    e.rejected = 0;
+    e.falsePositives = 0;
+}
+
+void printRow(const BenchRow& r) {
+    cout << left << setw(16) << r.engine << setw(12) << r.workload << right << setw(11) << r.n
+         << setw(10) << fixed << setprecision(1) << r.meanNs << setw(8) << r.p50 << setw(8) << r.p99
+         << setw(9) << r.p999 << setw(10) << r.maxNs << setw(9) << setprecision(2) << r.mopsPerSec << setw(8) << setprecision(1) << r.bytesPerKey << "\n";
+}
+
+template <typename Engine, typename Key>
+void runSuite(const Config& cfg, size_t n, uint64_t overhead, vector<BenchRow>& rows) {
+    unique_ptr<Engine> engine(new Engine());
+    KeySpace ks(n);
+    size_t sink = 0;
+
+    // Build: insert semua key dalam urutan acak. Untuk n besar hanya
+    // sebagian sampel latensi yang disimpan.
+    {
+        vector<uint64_t> order = ks.live;
+        shuffle(order.begin(), order.end(), ks.rng);
+        size_t stride = max<size_t>(1, n / 10000000);
+        LatencyStats stats;
+        stats.reserve(n / stride + 1);
+        uint64_t total = 0;
+        for (size_t i = 0; i < n; i++) {
+            Key key = makeKey<Key>(order[i]);
+            uint64_t t0 = nowNs();
+            sink += engine->insert(key);
+            uint64_t ns = nowNs() - t0;
+            ns = ns > overhead ? ns - overhead : 0;
+            total += ns;
+            if (i % stride == 0) stats.add(ns);
+        }
+        printFilterStats(*engine, 0);
+        BenchRow row = makeRow(Engine::name(), "build", cfg, n, n, 1, stats, 0);
+        row.meanNs = (double)total / n;
+        row.mopsPerSec = row.meanNs > 0 ? 1000.0 / row.meanNs : 0;
+        row.bytesPerKey = engine->memoryStats().bytesPerKey();
+        printRow(row);
+        rows.push_back(row);
+    }
+
+    for (const string& workload : cfg.workloads) {
+        LatencyStats stats;
+        stats.reserve(cfg.ops * cfg.reps);
+        uint64_t total = 0;
+        for (int rep = 0; rep < cfg.warmup + cfg.reps; rep++) {
+            vector<Op<Key>> ops = generate<Key>(workload, ks, cfg.ops);
+            bool record = rep >= cfg.warmup;
+            if (workload == "batch") {
+                // Lookup uniform yang sama, tapi dikirim per batch lewat
+                // searchBatch; setiap key mendapat rata-rata waktu batch-nya.
+                vector<Key> keys(cfg.batch);
+                unique_ptr<bool[]> found(new bool[cfg.batch]);
+                for (size_t i = 0; i < ops.size(); i += cfg.batch) {
+                    size_t count = min(cfg.batch, ops.size() - i);
+                    for (size_t j = 0; j < count; j++) keys[j] = ops[i + j].key;
+                    uint64_t t0 = nowNs();
+                    engine->findBatch(keys.data(), count, found.get());
+                    uint64_t ns = nowNs() - t0;
+                    ns = ns > overhead ? ns - overhead : 0;
+                    for (size_t j = 0; j < count; j++) sink += found[j];
+                    if (record) {
+                        for (size_t j = 0; j < count; j++) stats.add(ns / count);
+                        total += ns;
+                    }
+                }
+                continue;
+            }
+            for (const Op<Key>& op : ops) {
+                uint64_t t0 = nowNs();
+                sink += apply(*engine, op);
+                uint64_t ns = nowNs() - t0;
+                ns = ns > overhead ? ns - overhead : 0;
+                if (record) {
+                    stats.add(ns);
+                    total += ns;
+                }
+            }
+        }
+        BenchRow row = makeRow(Engine::name(), workload, cfg, n, cfg.ops, cfg.reps, stats, total);
+        row.bytesPerKey = engine->memoryStats().bytesPerKey();
+        printRow(row);
+        printFilterStats(*engine, 0);
+        rows.push_back(row);
+    }
+    benchSink += sink;
+}
+
+template <typename Key>
+bool runEngine(const Config& cfg, const string& engine, size_t n, uint64_t overhead,
+               vector<BenchRow>& rows) {
+    constexpr int BPLUS_ORDER = is_same<Key, int>::value ? 64 : 16;
+    if (engine == "hash-chain") {
+        if (n > cfg.chainMax) {
+            cout << left << setw(16) << engine << "n = " << n << " dilewati (chain 26 bucket, --chain-max "
+                 << cfg.chainMax << ")\n";
+            return true;
+        }
+        runSuite<ChainedHashEngine<Key>, Key>(cfg, n, overhead, rows);
+    } else if (engine == "hash-open") {
+        runSuite<OpenHashEngine<Key>, Key>(cfg, n, overhead, rows);
+    } else if (engine == "bplus") {
+        runSuite<BPlusEngine<Key, BPLUS_ORDER>, Key>(cfg, n, overhead, rows);
+    } else if (engine == "bplus-lazy") {
+        runSuite<BPlusEngine<Key, BPLUS_ORDER, true>, Key>(cfg, n, overhead, rows);
+    } else if (engine == "hash-open+cf") {
+        runSuite<FilteredEngine<OpenHashEngine<Key>, Key>, Key>(cfg, n, overhead, rows);
+    } else if (engine == "bplus+cf") {
+        runSuite<FilteredEngine<BPlusEngine<Key, BPLUS_ORDER>, Key>, Key>(cfg, n, overhead, rows);
+    } else {
+        cerr << "Engine tidak dikenal: " << engine << endl;
+        return false;
+    }
+    return true;
+}
+
+vector<string> splitList(const string& s) {
+    vector<string> parts;
+    stringstream ss(s);
+    string item;
+    while (getline(ss, item, ',')) {
+        if (!item.empty()) parts.push_back(item);
+    }
+    return parts;
+}
+
+void usage(const char* prog) {
+    cerr << "Usage: " << prog << " [--sizes 1000,100000,...] [--engines hash-chain,hash-open,bplus,bplus-lazy,hash-open+cf,bplus+cf]\n"
+         << "       [--workloads uniform,batch,zipf,sequential,miss,miss-heavy,mix-rw,mix-update]\n"
+         << "       [--batch B] [--chain-max N]\n"
+         << "       [--ops N] [--reps R] [--warmup W] [--type int|string]\n"
+         << "       [--csv file.csv] [--json file.json]\n";
+}
+
+int main(int argc, char* argv[]) {
+    Config cfg;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--sizes") {
+            cfg.sizes.clear();
+            for (const string& s : splitList(value)) cfg.sizes.push_back(strtoull(s.c_str(), nullptr, 10));
+        } else if (arg == "--engines") {
+            cfg.engines = splitList(value);
+        } else if (arg == "--workloads") {
+            cfg.workloads = splitList(value);
+        } else if (arg == "--ops") {
+            cfg.ops = strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--reps") {
+            cfg.reps = atoi(value.c_str());
+        } else if (arg == "--warmup") {
+            cfg.warmup = atoi(value.c_str());
+        } else if (arg == "--batch") {
+            cfg.batch = max<size_t>(1, strtoull(value.c_str(), nullptr, 10));
+        } else if (arg == "--chain-max") {
+            cfg.chainMax = strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--type") {
+            cfg.keyType = value;
+        } else if (arg == "--csv") {
+            cfg.csvPath = value;
+        } else if (arg == "--json") {
+            cfg.jsonPath = value;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (cfg.keyType != "int" && cfg.keyType != "string") {
+        usage(argv[0]);
+        return 1;
+    }
+
+    uint64_t overhead = timerOverheadNs();
+    cout << "Overhead timer: " << overhead << " ns (dikurangkan dari setiap sampel), key " << cfg.keyType
+         << ", " << cfg.ops << " operasi x " << cfg.reps << " repetisi (+" << cfg.warmup << " warm-up)\n\n";
+    cout << left << setw(16) << "engine" << setw(12) << "workload" << right << setw(11) << "n"
+         << setw(10) << "mean ns" << setw(8) << "p50" << setw(8) << "p99" << setw(9) << "p999"
+         << setw(10) << "max" << setw(9) << "Mops/s" << setw(8) << "B/key" << "\n";
+
+    vector<BenchRow> rows;
+    for (size_t n : cfg.sizes) {
+        for (const string& engine : cfg.engines) {
+            bool ok = cfg.keyType == "int" ? runEngine<int>(cfg, engine, n, overhead, rows)
+                                           : runEngine<string>(cfg, engine, n, overhead, rows);
+            if (!ok) return 1;
+        }
+    }
+
+    if (!cfg.csvPath.empty() && !writeCsv(cfg.csvPath.c_str(), rows)) {
+        cerr << "Error menulis " << cfg.csvPath << endl;
+        return 1;
+    }
+    if (!cfg.jsonPath.empty() && !writeJson(cfg.jsonPath.c_str(), rows)) {
+        cerr << "Error menulis " << cfg.jsonPath << endl;
+        return 1;
+    }
+    return 0;
+}
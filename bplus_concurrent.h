@@ -0,0 +1,429 @@
+#ifndef BPLUS_CONCURRENT_H
+#define BPLUS_CONCURRENT_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "bplus_tree.h"
+#include "node_pool.h"
+
+// Version latch per node untuk optimistic lock coupling. Versi ganjil =
+// terkunci; mengunci dan melepas kunci masing-masing menaikkan versi satu.
+// Node tidak pernah dibebaskan maupun digabung (lihat ConcurrentBPlusTree),
+// jadi tidak perlu tanda obsolete. Pembaca tidak pernah menulis ke latch:
+// baca versi, baca isi node, lalu cek versinya tidak berubah; kalau berubah,
+// operasi diulang dari root.
+class VersionLatch {
+public:
+    uint64_t readLockOrRestart(bool& restart) const {
+        uint64_t v = version_.load(std::memory_order_acquire);
+        if (v & 1) restart = true;
+        return v;
+    }
+
+    // Pola seqlock: isi node dibaca dengan load relaxed, fence acquire di
+    // sini mengurutkannya sebelum versi dibaca ulang.
+    void readUnlockOrRestart(uint64_t v, bool& restart) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (version_.load(std::memory_order_relaxed) != v) restart = true;
+    }
+
+    void upgradeToWriteLockOrRestart(uint64_t& v, bool& restart) {
+        if (version_.compare_exchange_strong(v, v + 1, std::memory_order_acquire)) {
+            v += 1;
+        } else {
+            restart = true;
+        }
+    }
+
+    // Dipanggil sekali setelah semua kunci diambil: tulisan isi node (store
+    // relaxed) sesudahnya tidak boleh terlihat sebelum versi terkunci.
+    void writeLocked() const { std::atomic_thread_fence(std::memory_order_release); }
+
+    void writeUnlock() { version_.fetch_add(1, std::memory_order_release); }
+
+private:
+    std::atomic<uint64_t> version_{0};
+};
+
+// Sel untuk data node yang dibaca tanpa kunci. T (trivially copyable)
+// disimpan sebagai word atomik dan dibaca/ditulis per word dengan
+// memory_order_relaxed, jadi baca bersamaan dengan tulis bukan data race.
+// Hasil baca bisa campuran dua tulisan; karena itu versi node tetap
+// divalidasi sebelum hasilnya dipakai.
+template <typename T>
+class RelaxedCell {
+    using Word = typename std::conditional<
+        sizeof(T) % 8 == 0, uint64_t,
+        typename std::conditional<sizeof(T) % 4 == 0, uint32_t,
+                                  typename std::conditional<sizeof(T) % 2 == 0, uint16_t, uint8_t>::type>::type>::type;
+    static constexpr size_t WORDS = sizeof(T) / sizeof(Word);
+
+public:
+    T load() const {
+        Word buf[WORDS];
+        for (size_t i = 0; i < WORDS; i++) buf[i] = words_[i].load(std::memory_order_relaxed);
+        T v;
+        memcpy(&v, buf, sizeof(T));
+        return v;
+    }
+
+    void store(const T& v) {
+        Word buf[WORDS];
+        memcpy(buf, &v, sizeof(T));
+        for (size_t i = 0; i < WORDS; i++) words_[i].store(buf[i], std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<Word> words_[WORDS];
+};
+
+// Array sel berkapasitas tetap; value kosong (BPlusEmpty) tidak disimpan.
+template <typename T, int N, bool Empty = std::is_empty<T>::value>
+struct RelaxedArray {
+    RelaxedCell<T> cells[N];
+
+    T load(int i) const { return cells[i].load(); }
+    void store(int i, const T& v) { cells[i].store(v); }
+
+    // Jumlah elemen [0, n) yang memenuhi pred (pencarian node tanpa cabang).
+    template <typename Pred>
+    int count(int n, Pred pred) const {
+        int c = 0;
+        for (int i = 0; i < n; i++) c += pred(load(i));
+        return c;
+    }
+
+    // Seperti memmove: geser count elemen dari index `from` ke `to`.
+    void move(int to, int from, int count) {
+        if (to > from) {
+            for (int i = count - 1; i >= 0; i--) store(to + i, load(from + i));
+        } else {
+            for (int i = 0; i < count; i++) store(to + i, load(from + i));
+        }
+    }
+};
+
+template <typename T, int N>
+struct RelaxedArray<T, N, true> {
+    T load(int) const { return T(); }
+    void store(int, const T&) {}
+    void move(int, int, int) {}
+};
+
+// B+ tree yang aman dipakai banyak thread sekaligus (optimistic lock
+// coupling). Pencarian tidak mengambil kunci apa pun; insert/remove hanya
+// mengunci leaf yang diubah, dan saat split juga parent-nya. Node internal
+// yang penuh dipecah sambil turun, jadi split tidak pernah merambat ke atas
+// dan tidak perlu pointer parent.
+//
+// Key dan Value harus trivially copyable: pembaca menyalin isi node tanpa
+// kunci lewat load atomik relaxed (count, key, value, pointer anak) lalu
+// membuang hasilnya kalau versi node berubah. Penulis memakai store relaxed
+// di bawah kunci, jadi tidak ada data race dan tree bisa diperiksa dengan
+// TSan. Leaf yang kosong tidak digabung, sehingga node tidak pernah
+// dibebaskan selama tree hidup dan pembaca tidak butuh reclamation.
+template <typename Key, typename Value = BPlusEmpty, int Order = 64,
+          typename Compare = std::less<Key>>
+class ConcurrentBPlusTree {
+    static_assert(Order >= 3, "Order B+ tree minimal 3");
+    static_assert(std::is_trivially_copyable<Key>::value, "Key harus trivially copyable");
+    static_assert(std::is_trivially_copyable<Value>::value, "Value harus trivially copyable");
+
+    static constexpr int CAPACITY = Order - 1;  // key per node
+
+    // isLeaf tidak pernah berubah setelah node dibuat, dan node baru
+    // terlihat pembaca hanya lewat pointer yang dipasang di bawah kunci.
+    struct Node {
+        VersionLatch latch;
+        const bool isLeaf;
+        std::atomic<int> count;
+        RelaxedArray<Key, CAPACITY> keys;
+
+        explicit Node(bool leaf) : isLeaf(leaf), count(0) {}
+        int size() const { return count.load(std::memory_order_relaxed); }
+        bool full() const { return size() == CAPACITY; }
+    };
+
+    struct alignas(64) Leaf : Node {
+        RelaxedArray<Value, CAPACITY> values;
+        Leaf* next;  // hanya disentuh penulis yang memegang kunci
+
+        Leaf() : Node(true), next(nullptr) {}
+    };
+
+    struct alignas(64) Inner : Node {
+        std::atomic<Node*> children[Order];
+
+        Inner() : Node(false) {}
+        Node* child(int i) const { return children[i].load(std::memory_order_relaxed); }
+        void setChild(int i, Node* node) { children[i].store(node, std::memory_order_relaxed); }
+    };
+
+public:
+    ConcurrentBPlusTree() { root_.store(newLeaf()); }
+    explicit ConcurrentBPlusTree(Compare comp) : comp_(comp) { root_.store(newLeaf()); }
+
+    ConcurrentBPlusTree(const ConcurrentBPlusTree&) = delete;
+    ConcurrentBPlusTree& operator=(const ConcurrentBPlusTree&) = delete;
+
+    bool search(const Key& key, Value* value = nullptr) const {
+        for (int attempt = 0;; attempt++) {
+            backoff(attempt);
+            bool restart = false;
+            uint64_t version;
+            Leaf* leaf = findLeaf(key, version, restart);
+            if (restart) continue;
+
+            int n = leaf->size();
+            int pos = lowerBound(leaf, n, key);
+            bool found = pos < n && equal(leaf->keys.load(pos), key);
+            Value copy{};
+            if (found) copy = leaf->values.load(pos);
+            leaf->latch.readUnlockOrRestart(version, restart);
+            if (restart) continue;
+            if (found && value) *value = copy;
+            return found;
+        }
+    }
+
+    bool insert(const Key& key, const Value& value = Value()) {
+        for (int attempt = 0;; attempt++) {
+            backoff(attempt);
+            bool restart = false;
+            Node* node = root_.load(std::memory_order_acquire);
+            uint64_t version = node->latch.readLockOrRestart(restart);
+            if (restart || node != root_.load(std::memory_order_acquire)) continue;
+
+            Inner* parent = nullptr;
+            uint64_t parentVersion = 0;
+
+            while (!node->isLeaf) {
+                Inner* inner = static_cast<Inner*>(node);
+                if (inner->full()) {
+                    splitNode(parent, parentVersion, node, version, restart);
+                    break;
+                }
+                if (parent) {
+                    parent->latch.readUnlockOrRestart(parentVersion, restart);
+                    if (restart) break;
+                }
+                parent = inner;
+                parentVersion = version;
+                node = inner->child(upperBound(inner, inner->size(), key));
+                inner->latch.readUnlockOrRestart(version, restart);
+                if (restart) break;
+                version = node->latch.readLockOrRestart(restart);
+                if (restart) break;
+            }
+            if (restart || !node->isLeaf) continue;
+
+            Leaf* leaf = static_cast<Leaf*>(node);
+            if (leaf->full()) {
+                splitNode(parent, parentVersion, node, version, restart);
+                continue;
+            }
+
+            leaf->latch.upgradeToWriteLockOrRestart(version, restart);
+            if (restart) continue;
+            leaf->latch.writeLocked();
+            if (parent) {
+                parent->latch.readUnlockOrRestart(parentVersion, restart);
+                if (restart) {
+                    leaf->latch.writeUnlock();
+                    continue;
+                }
+            }
+
+            int n = leaf->size();
+            int pos = lowerBound(leaf, n, key);
+            bool inserted = !(pos < n && equal(leaf->keys.load(pos), key));
+            if (inserted) {
+                leaf->keys.move(pos + 1, pos, n - pos);
+                leaf->values.move(pos + 1, pos, n - pos);
+                leaf->keys.store(pos, key);
+                leaf->values.store(pos, value);
+                leaf->count.store(n + 1, std::memory_order_relaxed);
+                size_.fetch_add(1, std::memory_order_relaxed);
+            }
+            leaf->latch.writeUnlock();
+            return inserted;
+        }
+    }
+
+    // Hapus dari leaf saja; leaf yang kurus atau kosong dibiarkan (lihat
+    // catatan kelas), separator di atasnya tetap valid sebagai batas.
+    bool remove(const Key& key) {
+        for (int attempt = 0;; attempt++) {
+            backoff(attempt);
+            bool restart = false;
+            uint64_t version;
+            Leaf* leaf = findLeaf(key, version, restart);
+            if (restart) continue;
+            leaf->latch.upgradeToWriteLockOrRestart(version, restart);
+            if (restart) continue;
+            leaf->latch.writeLocked();
+
+            int n = leaf->size();
+            int pos = lowerBound(leaf, n, key);
+            bool removed = pos < n && equal(leaf->keys.load(pos), key);
+            if (removed) {
+                leaf->keys.move(pos, pos + 1, n - pos - 1);
+                leaf->values.move(pos, pos + 1, n - pos - 1);
+                leaf->count.store(n - 1, std::memory_order_relaxed);
+                size_.fetch_sub(1, std::memory_order_relaxed);
+            }
+            leaf->latch.writeUnlock();
+            return removed;
+        }
+    }
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+
+private:
+    std::atomic<Node*> root_{nullptr};
+    std::atomic<size_t> size_{0};
+    Compare comp_;
+    // Pool tidak thread-safe; alokasi hanya terjadi saat split.
+    std::mutex poolMutex_;
+    NodePool<Leaf> leafPool_;
+    NodePool<Inner> innerPool_;
+
+    Leaf* newLeaf() {
+        std::lock_guard<std::mutex> guard(poolMutex_);
+        return leafPool_.create();
+    }
+
+    Inner* newInner() {
+        std::lock_guard<std::mutex> guard(poolMutex_);
+        return innerPool_.create();
+    }
+
+    // Turun ke leaf dengan lock coupling optimistik: versi parent divalidasi
+    // ulang setelah versi anak dibaca, jadi split anak yang terjadi di
+    // antaranya (yang selalu mengubah parent) ikut terdeteksi. `version`
+    // adalah versi leaf yang harus divalidasi pemanggil.
+    Leaf* findLeaf(const Key& key, uint64_t& version, bool& restart) const {
+        Node* node = root_.load(std::memory_order_acquire);
+        version = node->latch.readLockOrRestart(restart);
+        if (restart || node != root_.load(std::memory_order_acquire)) {
+            restart = true;
+            return nullptr;
+        }
+        while (!node->isLeaf) {
+            Inner* inner = static_cast<Inner*>(node);
+            uint64_t innerVersion = version;
+            node = inner->child(upperBound(inner, inner->size(), key));
+            inner->latch.readUnlockOrRestart(innerVersion, restart);
+            if (restart) return nullptr;
+            version = node->latch.readLockOrRestart(restart);
+            if (restart) return nullptr;
+            inner->latch.readUnlockOrRestart(innerVersion, restart);
+            if (restart) return nullptr;
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    // Setelah beberapa kali gagal validasi, beri kesempatan penulis selesai.
+    static void backoff(int attempt) {
+        if (attempt > 3) std::this_thread::yield();
+    }
+
+    bool equal(const Key& a, const Key& b) const {
+        return !comp_(a, b) && !comp_(b, a);
+    }
+
+    // Kernel SIMD node_search.h butuh array biasa, dan menyalin node ke
+    // buffer lokal lebih mahal dari hitungan tanpa cabang langsung di atas
+    // load relaxed. `n` adalah count yang sudah dibaca pemanggil; count selalu
+    // berisi nilai yang pernah ditulis (0..CAPACITY), jadi indeks tidak keluar
+    // array walaupun isi node sedang diubah.
+    int upperBound(const Node* node, int n, const Key& key) const {
+        return node->keys.count(n, [&](const Key& k) { return !comp_(key, k); });
+    }
+
+    int lowerBound(const Node* node, int n, const Key& key) const {
+        return node->keys.count(n, [&](const Key& k) { return comp_(k, key); });
+    }
+
+    // Kunci parent (kalau ada) lalu node, pecah node menjadi dua, dan pasang
+    // separator di parent. Parent dijamin tidak penuh karena node internal
+    // yang penuh sudah dipecah saat turun. Pemanggil selalu mengulang dari
+    // root setelahnya.
+    void splitNode(Inner* parent, uint64_t parentVersion, Node* node, uint64_t version, bool& restart) {
+        if (parent) {
+            parent->latch.upgradeToWriteLockOrRestart(parentVersion, restart);
+            if (restart) return;
+        }
+        node->latch.upgradeToWriteLockOrRestart(version, restart);
+        if (restart) {
+            if (parent) parent->latch.writeUnlock();
+            return;
+        }
+        node->latch.writeLocked();
+        if (!parent && node != root_.load(std::memory_order_acquire)) {
+            node->latch.writeUnlock();
+            restart = true;
+            return;
+        }
+
+        Key separator;
+        Node* right;
+        // Sibling baru belum terlihat pembaca sampai pointer-nya dipasang di
+        // parent (atau root baru), yang dilepas dengan release.
+        int count = node->size();
+        if (node->isLeaf) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            Leaf* sibling = newLeaf();
+            int mid = count / 2;
+            for (int i = mid; i < count; i++) {
+                sibling->keys.store(i - mid, leaf->keys.load(i));
+                sibling->values.store(i - mid, leaf->values.load(i));
+            }
+            sibling->count.store(count - mid, std::memory_order_relaxed);
+            sibling->next = leaf->next;
+            leaf->count.store(mid, std::memory_order_relaxed);
+            leaf->next = sibling;
+            separator = sibling->keys.load(0);
+            right = sibling;
+        } else {
+            Inner* inner = static_cast<Inner*>(node);
+            Inner* sibling = newInner();
+            int mid = count / 2;
+            for (int i = mid + 1; i < count; i++) sibling->keys.store(i - mid - 1, inner->keys.load(i));
+            for (int i = mid + 1; i <= count; i++) sibling->setChild(i - mid - 1, inner->child(i));
+            sibling->count.store(count - mid - 1, std::memory_order_relaxed);
+            separator = inner->keys.load(mid);
+            inner->count.store(mid, std::memory_order_relaxed);
+            right = sibling;
+        }
+
+        if (parent) {
+            int n = parent->size();
+            int pos = upperBound(parent, n, separator);
+            parent->keys.move(pos + 1, pos, n - pos);
+            for (int i = n; i > pos; i--) parent->setChild(i + 1, parent->child(i));
+            parent->keys.store(pos, separator);
+            parent->setChild(pos + 1, right);
+            parent->count.store(n + 1, std::memory_order_relaxed);
+        } else {
+            Inner* newRoot = newInner();
+            newRoot->keys.store(0, separator);
+            newRoot->setChild(0, node);
+            newRoot->setChild(1, right);
+            newRoot->count.store(1, std::memory_order_relaxed);
+            root_.store(newRoot, std::memory_order_release);
+        }
+
+        node->latch.writeUnlock();
+        if (parent) parent->latch.writeUnlock();
+    }
+};
+
+#endif
@@ -0,0 +1,342 @@
+#ifndef BPLUS_FILE_H
+#define BPLUS_FILE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bplus_tree.h"
+
+// Format file B+ tree biner berbasis page:
+//   page 0      : FileHeader (root, leaf pertama, jumlah key, ...)
+//   page 1..L   : leaf, terurut, saling tersambung lewat `next`
+//   page L+1..  : node internal, level demi level, root paling akhir
+// Semua page berukuran PAGE_SIZE sehingga file bisa di-mmap dan dibaca
+// langsung tanpa parsing maupun copy.
+namespace bplus_file {
+
+const uint32_t PAGE_SIZE = 4096;
+const char MAGIC[8] = {'B', 'P', 'T', 'R', 'E', 'E', '0', '1'};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t pageSize;
+    uint32_t keyBytes;
+    uint32_t valueBytes;
+    uint32_t rootPage;
+    uint32_t firstLeaf;
+    uint32_t height;
+    uint64_t keyCount;
+    uint64_t pageCount;
+    uint64_t walLsn;  // record WAL terakhir yang sudah termasuk di snapshot (0 = tidak ada)
+};
+
+// Page id 0 selalu header, jadi next = 0 berarti tidak ada leaf berikutnya.
+struct PageHeader {
+    uint16_t isLeaf;
+    uint16_t count;
+    uint32_t next;
+};
+
+constexpr size_t alignUp(size_t n, size_t align) {
+    return (n + align - 1) / align * align;
+}
+
+template <typename Key, typename Value>
+struct PageLayout {
+    static_assert(std::is_trivially_copyable<Key>::value, "Key file B+ tree harus trivially copyable");
+    static_assert(std::is_trivially_copyable<Value>::value, "Value file B+ tree harus trivially copyable");
+    static_assert(alignof(Key) <= 8 && alignof(Value) <= 8, "Alignment key/value maksimal 8");
+
+    static constexpr size_t VALUE_BYTES = std::is_empty<Value>::value ? 0 : sizeof(Value);
+    static constexpr size_t KEYS_OFFSET = sizeof(PageHeader);
+
+    static constexpr size_t LEAF_CAP =
+        (PAGE_SIZE - KEYS_OFFSET - alignof(Value)) / (sizeof(Key) + VALUE_BYTES);
+    static constexpr size_t VALUES_OFFSET = alignUp(KEYS_OFFSET + LEAF_CAP * sizeof(Key), alignof(Value));
+
+    static constexpr size_t INNER_CAP = (PAGE_SIZE - KEYS_OFFSET - 8) / (sizeof(Key) + sizeof(uint32_t));
+    static constexpr size_t CHILDREN_OFFSET = alignUp(KEYS_OFFSET + INNER_CAP * sizeof(Key), 4);
+
+    static_assert(LEAF_CAP >= 2 && INNER_CAP >= 2, "Key terlalu besar untuk satu page");
+};
+
+}  // namespace bplus_file
+
+// Tulis isi tree (key terurut beserta value) ke file page biner. Leaf
+// diisi penuh karena file ini snapshot read-only. `walLsn` dicatat di header
+// untuk checkpoint WAL (bplus_wal.h). Dengan `sync`, file di-fsync sebelum
+// ditutup. MappedBPlusFile selalu mencari dengan operator<, jadi hanya tree
+// dengan urutan bawaan yang boleh disimpan.
+template <typename Key, typename Value, int Order, typename Compare>
+bool saveBPlusFile(const BPlusTree<Key, Value, Order, Compare>& tree, const char* path, uint64_t walLsn = 0,
+                   bool sync = false) {
+    static_assert(std::is_same<Compare, std::less<Key>>::value,
+                  "File B+ tree hanya untuk tree dengan std::less<Key> (urutan yang dipakai MappedBPlusFile)");
+    using namespace bplus_file;
+    typedef PageLayout<Key, Value> Layout;
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    std::vector<unsigned char> page(PAGE_SIZE);
+    bool ok = fwrite(page.data(), 1, PAGE_SIZE, f) == PAGE_SIZE;  // placeholder header
+
+    uint32_t nextId = 1;
+    std::vector<std::pair<Key, uint32_t>> level;  // key terkecil + page id
+
+    size_t n = tree.size();
+    size_t leafCount = std::max<size_t>(1, (n + Layout::LEAF_CAP - 1) / Layout::LEAF_CAP);
+    auto it = tree.begin();
+    for (size_t i = 0; i < leafCount && ok; i++) {
+        std::fill(page.begin(), page.end(), 0);
+        PageHeader* header = reinterpret_cast<PageHeader*>(page.data());
+        Key* keys = reinterpret_cast<Key*>(page.data() + Layout::KEYS_OFFSET);
+        Value* values = reinterpret_cast<Value*>(page.data() + Layout::VALUES_OFFSET);
+
+        size_t take = std::min(Layout::LEAF_CAP, n - i * Layout::LEAF_CAP);
+        if (n == 0) take = 0;
+        for (size_t j = 0; j < take; j++, ++it) {
+            keys[j] = it.key();
+            if (Layout::VALUE_BYTES) memcpy(&values[j], &it.value(), sizeof(Value));
+        }
+        header->isLeaf = 1;
+        header->count = take;
+        header->next = (i + 1 < leafCount) ? nextId + 1 : 0;
+        level.push_back({take ? keys[0] : Key(), nextId++});
+        ok = fwrite(page.data(), 1, PAGE_SIZE, f) == PAGE_SIZE;
+    }
+
+    uint32_t height = 1;
+    while (level.size() > 1 && ok) {
+        size_t childCount = level.size();
+        size_t parentCount = (childCount + Layout::INNER_CAP) / (Layout::INNER_CAP + 1);
+        std::vector<std::pair<Key, uint32_t>> parents;
+        size_t c = 0;
+        for (size_t i = 0; i < parentCount && ok; i++) {
+            size_t take = childCount / parentCount + (i < childCount % parentCount ? 1 : 0);
+            std::fill(page.begin(), page.end(), 0);
+            PageHeader* header = reinterpret_cast<PageHeader*>(page.data());
+            Key* keys = reinterpret_cast<Key*>(page.data() + Layout::KEYS_OFFSET);
+            uint32_t* children = reinterpret_cast<uint32_t*>(page.data() + Layout::CHILDREN_OFFSET);
+
+            parents.push_back({level[c].first, nextId++});
+            for (size_t j = 0; j < take; j++, c++) {
+                children[j] = level[c].second;
+                if (j > 0) keys[j - 1] = level[c].first;
+            }
+            header->isLeaf = 0;
+            header->count = take - 1;
+            ok = fwrite(page.data(), 1, PAGE_SIZE, f) == PAGE_SIZE;
+        }
+        level.swap(parents);
+        height++;
+    }
+
+    std::fill(page.begin(), page.end(), 0);
+    FileHeader* header = reinterpret_cast<FileHeader*>(page.data());
+    memcpy(header->magic, MAGIC, sizeof(MAGIC));
+    header->pageSize = PAGE_SIZE;
+    header->keyBytes = sizeof(Key);
+    header->valueBytes = Layout::VALUE_BYTES;
+    header->rootPage = level[0].second;
+    header->firstLeaf = 1;
+    header->height = height;
+    header->keyCount = n;
+    header->pageCount = nextId;
+    header->walLsn = walLsn;
+    ok = ok && fseek(f, 0, SEEK_SET) == 0 && fwrite(page.data(), 1, PAGE_SIZE, f) == PAGE_SIZE;
+    if (sync) ok = ok && fflush(f) == 0 && fsync(fileno(f)) == 0;
+    return fclose(f) == 0 && ok;
+}
+
+// Pembaca file B+ tree lewat mmap. Lookup dan scan membaca page langsung
+// dari mapping (zero copy). Saat dibuka, header setiap page diperiksa sekali
+// (count, id anak dan `next`) supaya file rusak tidak membuat pembacaan
+// keluar dari mapping atau berputar tanpa akhir.
+template <typename Key, typename Value = BPlusEmpty>
+class MappedBPlusFile {
+    typedef bplus_file::PageLayout<Key, Value> Layout;
+
+public:
+    MappedBPlusFile() = default;
+    ~MappedBPlusFile() { close(); }
+
+    MappedBPlusFile(const MappedBPlusFile&) = delete;
+    MappedBPlusFile& operator=(const MappedBPlusFile&) = delete;
+
+    // Mengembalikan false (dan pesan di `error`) kalau file tidak bisa
+    // dibuka atau formatnya tidak cocok dengan Key/Value.
+    bool open(const char* path, std::string* error = nullptr) {
+        using namespace bplus_file;
+        close();
+        auto fail = [&](const std::string& msg) {
+            if (error) *error = msg;
+            close();
+            return false;
+        };
+
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return fail(std::string("tidak dapat membuka ") + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < (off_t)PAGE_SIZE) {
+            ::close(fd);
+            return fail("file terlalu kecil");
+        }
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) return fail("mmap gagal");
+        data_ = static_cast<const unsigned char*>(data);
+        length_ = st.st_size;
+
+        header_ = reinterpret_cast<const FileHeader*>(data_);
+        if (memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0) return fail("bukan file B+ tree");
+        if (header_->pageSize != PAGE_SIZE || header_->keyBytes != sizeof(Key) ||
+            header_->valueBytes != Layout::VALUE_BYTES) {
+            return fail("ukuran page/key/value tidak cocok");
+        }
+        if (header_->pageCount > length_ / PAGE_SIZE) return fail("file terpotong");
+        if (!validPages()) return fail("page rusak");
+        return true;
+    }
+
+    void close() {
+        if (data_) munmap(const_cast<unsigned char*>(data_), length_);
+        data_ = nullptr;
+        header_ = nullptr;
+        length_ = 0;
+    }
+
+    bool isOpen() const { return data_ != nullptr; }
+    size_t size() const { return header_->keyCount; }
+    uint32_t height() const { return header_->height; }
+    size_t pageCount() const { return header_->pageCount; }
+    uint64_t walLsn() const { return header_->walLsn; }
+
+    // Pointer ke value di dalam mapping, nullptr kalau key tidak ada.
+    const Value* find(const Key& key, int* count = nullptr) const {
+        const unsigned char* leaf = findLeaf(key);
+        int n = header(leaf)->count;
+        int pos = lowerBound(keys(leaf), n, key);
+        bool found = pos < n && !(key < keys(leaf)[pos]);
+        if (count) *count += found ? pos + 1 : n;
+        return found ? values(leaf) + pos : nullptr;
+    }
+
+    bool search(const Key& key, int* count = nullptr) const {
+        return find(key, count) != nullptr;
+    }
+
+    // Panggil fn(key, value) untuk key di [start, end], seperti BPlusTree::scan.
+    template <typename Fn>
+    size_t scan(const Key& start, const Key& end, Fn&& fn) const {
+        if (end < start) return 0;
+        const unsigned char* leaf = findLeaf(start);
+        int pos = lowerBound(keys(leaf), header(leaf)->count, start);
+        size_t delivered = 0;
+        while (leaf) {
+            const Key* k = keys(leaf);
+            for (int n = header(leaf)->count; pos < n; pos++) {
+                if (end < k[pos]) return delivered;
+                delivered++;
+                fn(k[pos], values(leaf)[pos]);
+            }
+            uint32_t next = header(leaf)->next;
+            leaf = next ? page(next) : nullptr;
+            pos = 0;
+        }
+        return delivered;
+    }
+
+    // Semua key terurut, dari leaf pertama.
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (uint32_t id = header_->firstLeaf; id; id = header(page(id))->next) {
+            const unsigned char* leaf = page(id);
+            for (int i = 0; i < header(leaf)->count; i++) fn(keys(leaf)[i], values(leaf)[i]);
+        }
+    }
+
+private:
+    const unsigned char* data_ = nullptr;
+    size_t length_ = 0;
+    const bplus_file::FileHeader* header_ = nullptr;
+
+    const unsigned char* page(uint32_t id) const { return data_ + (size_t)id * bplus_file::PAGE_SIZE; }
+
+    // Urutan tulis saveBPlusFile menjamin anak selalu ditulis sebelum
+    // parent-nya dan leaf berurutan, jadi id anak < id parent dan
+    // next > id leaf. Dengan itu penurunan dan scan pasti berhenti, dan
+    // setiap id yang diikuti sudah dicek ada di dalam file.
+    bool validPages() const {
+        uint64_t pages = header_->pageCount;
+        auto isLeafPage = [&](uint64_t id) { return id >= 1 && id < pages && header(page(id))->isLeaf == 1; };
+        if (header_->rootPage < 1 || header_->rootPage >= pages || !isLeafPage(header_->firstLeaf)) return false;
+        for (uint64_t id = 1; id < pages; id++) {
+            const bplus_file::PageHeader* h = header(page(id));
+            if (h->isLeaf == 1) {
+                if (h->count > Layout::LEAF_CAP) return false;
+                if (h->next != 0 && (h->next <= id || !isLeafPage(h->next))) return false;
+            } else if (h->isLeaf == 0) {
+                if (h->count > Layout::INNER_CAP) return false;
+                const uint32_t* c = children(page(id));
+                for (int i = 0; i <= h->count; i++) {
+                    if (c[i] < 1 || c[i] >= id) return false;
+                }
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static const bplus_file::PageHeader* header(const unsigned char* p) {
+        return reinterpret_cast<const bplus_file::PageHeader*>(p);
+    }
+    static const Key* keys(const unsigned char* p) {
+        return reinterpret_cast<const Key*>(p + Layout::KEYS_OFFSET);
+    }
+    static const Value* values(const unsigned char* p) {
+        return reinterpret_cast<const Value*>(p + Layout::VALUES_OFFSET);
+    }
+    static const uint32_t* children(const unsigned char* p) {
+        return reinterpret_cast<const uint32_t*>(p + Layout::CHILDREN_OFFSET);
+    }
+
+    static int upperBound(const Key* k, int n, const Key& key) {
+        if constexpr (std::is_same<Key, int>::value) {
+            return nodeUpperBound(k, n, key);
+        } else {
+            return std::upper_bound(k, k + n, key) - k;
+        }
+    }
+
+    static int lowerBound(const Key* k, int n, const Key& key) {
+        if constexpr (std::is_same<Key, int>::value) {
+            return nodeLowerBound(k, n, key);
+        } else {
+            return std::lower_bound(k, k + n, key) - k;
+        }
+    }
+
+    const unsigned char* findLeaf(const Key& key) const {
+        const unsigned char* p = page(header_->rootPage);
+        while (!header(p)->isLeaf) {
+            p = page(children(p)[upperBound(keys(p), header(p)->count, key)]);
+        }
+        return p;
+    }
+};
+
+#endif
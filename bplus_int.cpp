@@ -1,281 +1,329 @@
 #include <iostream>
 #include <vector>
 #include <chrono>
-#include <fstream>
 #include <cstdio>
 #include <algorithm>
 #include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <climits>
+#include <random>
+#include <thread>
+#include "bplus_tree.h"
+#include "bplus_file.h"
+#include "bplus_wal.h"
+#include "data_loader.h"
+#include "bench_util.h"
 
 using namespace std;
 using namespace chrono;
 
 const int ORDER = 4;
 
-struct BPlusNode {
-    bool isLeaf;
-    vector<int> keys;
-    vector<BPlusNode*> children;
-    BPlusNode* parent;
-    BPlusNode* next;
+typedef BPlusTree<int, BPlusEmpty, ORDER> Tree;
+typedef DurableBPlusTree<int, BPlusEmpty, ORDER> DurableTree;
 
-    BPlusNode(bool leaf) : isLeaf(leaf), parent(nullptr), next(nullptr) {}
-};
-
-BPlusNode* root = nullptr;
-
-void insertInternal(int, BPlusNode*, BPlusNode*);
-void removeInternal(int, BPlusNode*, BPlusNode*);
-
-void insert(int key) {
-    if (!root) {
-        root = new BPlusNode(true);
-        root->keys.push_back(key);
-        return;
+// Dipakai untuk Tree maupun DurableTree.
+template <typename T>
+void remove(T& tree, int key) {
+    if (tree.remove(key)) {
+        cout << "Hapus " << key << " berhasil.\n";
+    } else {
+        cout << key << " tidak ditemukan.\n";
     }
+}
 
-    BPlusNode* cursor = root;
-    while (!cursor->isLeaf) {
-        bool found = false;
-        for (int i = 0; i < cursor->keys.size(); i++) {
-            if (key < cursor->keys[i]) {
-                cursor = cursor->children[i];
-                found = true;
-                break;
-            }
-        }
-        if (!found) cursor = cursor->children.back();
+template <typename T>
+void update(T& tree, int oldKey, int newKey) {
+    if (tree.update(oldKey, newKey)) {
+        cout << oldKey << " di update menjadi " << newKey << endl;
+    } else if (tree.search(oldKey)) {
+        cout << "Nilai sudah ada.\n";
+    } else {
+        cout << oldKey << " tidak ditemukan.\n";
     }
+}
 
-    auto it = lower_bound(cursor->keys.begin(), cursor->keys.end(), key);
-    if (it != cursor->keys.end() && *it == key) return;
-    cursor->keys.insert(it, key);
-
-    if (cursor->keys.size() >= ORDER) {
-        BPlusNode* newLeaf = new BPlusNode(true);
-        int mid = (ORDER + 1) / 2;
-        newLeaf->keys.assign(cursor->keys.begin() + mid, cursor->keys.end());
-        cursor->keys.resize(mid);
-        newLeaf->next = cursor->next;
-        cursor->next = newLeaf;
-
-        if (cursor == root) {
-            root = new BPlusNode(false);
-            root->keys.push_back(newLeaf->keys[0]);
-            root->children.push_back(cursor);
-            root->children.push_back(newLeaf);
-            cursor->parent = root;
-            newLeaf->parent = root;
-        } else {
-            newLeaf->parent = cursor->parent;
-            insertInternal(newLeaf->keys[0], cursor->parent, newLeaf);
-        }
+// Baca semua key int dari file teks. Token yang bukan angka (misal header
+// "integer" di bplus.db) dilewati.
+bool readKeys(const char* filename, vector<int>& values) {
+    auto start = steady_clock::now();
+    DataFile file;
+    if (!file.open(filename)) {
+        cerr << "Error membuka file " << filename << endl;
+        return false;
     }
+    values.reserve(file.bytes() / 4);
+    size_t loaded = parseInts(file.text(), [&](int val) { values.push_back(val); });
+    printLoadStats(filename, file.bytes(), loaded, steady_clock::now() - start);
+    return true;
 }
 
-void insertInternal(int key, BPlusNode* cursor, BPlusNode* child) {
-    auto it = upper_bound(cursor->keys.begin(), cursor->keys.end(), key);
-    int index = it - cursor->keys.begin();
-    cursor->keys.insert(it, key);
-    cursor->children.insert(cursor->children.begin() + index + 1, child);
-
-    if (cursor->keys.size() >= ORDER) {
-        BPlusNode* newInternal = new BPlusNode(false);
-        int mid = ORDER / 2;
-
-        newInternal->keys.assign(cursor->keys.begin() + mid + 1, cursor->keys.end());
-        newInternal->children.assign(cursor->children.begin() + mid + 1, cursor->children.end());
-        int upKey = cursor->keys[mid];
-
-        cursor->keys.resize(mid);
-        cursor->children.resize(mid + 1);
+// Input terurut dibangun bottom-up dalam satu pass, selain itu diurutkan
+// dan dibangun bottom-up secara paralel dengan semua core.
+void buildTree(Tree& tree, vector<int>& values, double fillFactor) {
+    auto startLoad = high_resolution_clock::now();
+    bool sorted = is_sorted(values.begin(), values.end());
+    if (sorted) {
+        values.erase(unique(values.begin(), values.end()), values.end());
+        tree.bulkLoad(values.begin(), values.end(), fillFactor);
+    } else {
+        tree.buildParallel(values.begin(), values.end(), thread::hardware_concurrency(), fillFactor);
+    }
+    auto endLoad = high_resolution_clock::now();
+    cout << (sorted ? "Bulk load " : "Build paralel ") << tree.size() << " key dalam "
+         << duration_cast<microseconds>(endLoad - startLoad).count() << " us\n";
+    printMemoryStats("B+ tree", tree.memoryStats());
+}
 
-        for (auto c : newInternal->children) c->parent = newInternal;
+// --save: bangun tree dari file teks lalu tulis sebagai file page biner.
+int saveIndex(const char* input, const char* output) {
+    Tree tree;
+    vector<int> values;
+    if (!readKeys(input, values)) return 1;
+    buildTree(tree, values, 1.0);
 
-        if (cursor == root) {
-            root = new BPlusNode(false);
-            root->keys.push_back(upKey);
-            root->children.push_back(cursor);
-            root->children.push_back(newInternal);
-            cursor->parent = root;
-            newInternal->parent = root;
-        } else {
-            newInternal->parent = cursor->parent;
-            insertInternal(upKey, cursor->parent, newInternal);
-        }
+    auto start = high_resolution_clock::now();
+    if (!saveBPlusFile(tree, output)) {
+        cerr << "Error menulis file " << output << endl;
+        return 1;
     }
+    auto end = high_resolution_clock::now();
+    cout << "Disimpan ke " << output << " dalam "
+         << duration_cast<microseconds>(end - start).count() << " us\n";
+    return 0;
 }
 
-bool search(BPlusNode* cursor, int key, int* count) {
-    while (cursor && !cursor->isLeaf) {
-        bool found = false;
-        for (int i = 0; i < cursor->keys.size(); i++) {
-            if (key < cursor->keys[i]) {
-                cursor = cursor->children[i];
-                found = true;
-                break;
-            }
-        }
-        if (!found) cursor = cursor->children.back();
+// --open: buka file page lewat mmap dan cari key langsung di page.
+int openIndex(const char* path, const vector<int>& keys) {
+    MappedBPlusFile<int> index;
+    string error;
+    auto start = high_resolution_clock::now();
+    if (!index.open(path, &error)) {
+        cerr << "Error membuka index " << path << ": " << error << endl;
+        return 1;
     }
-    if (cursor) {
-        for (int k : cursor->keys) {
-            (*count)++;
-            if (k == key) return true;
-        }
+    auto end = high_resolution_clock::now();
+    cout << "Index " << path << " dibuka dalam " << duration_cast<microseconds>(end - start).count()
+         << " us: " << index.size() << " key, " << index.pageCount() << " page, tinggi "
+         << index.height() << "\n";
+
+    for (int key : keys) {
+        int count = 0;
+        start = high_resolution_clock::now();
+        bool found = index.search(key, &count);
+        end = high_resolution_clock::now();
+        cout << key << ": " << (found ? "Ditemukan" : "Tidak ditemukan") << " pada iterasi ke " << count
+             << ", waktu " << duration_cast<nanoseconds>(end - start).count() << " ns\n";
     }
-    return false;
+    return 0;
 }
 
-void remove(int key);
-
-void removeInternal(int key, BPlusNode* cursor, BPlusNode* child) {
-    auto it = find(cursor->keys.begin(), cursor->keys.end(), key);
-    int idx = it - cursor->keys.begin();
-    cursor->keys.erase(it);
-    cursor->children.erase(cursor->children.begin() + idx + 1);
-
-    if (cursor == root && cursor->keys.empty()) {
-        root = cursor->children[0];
-        delete cursor;
-        root->parent = nullptr;
-        return;
+// --batch: n key acak disisipkan ke tree yang sudah berisi n key, lalu
+// separuhnya dihapus; satu per satu (insert/remove) dibanding per batch
+// (insertBatch/eraseBatch) berukuran batchSize.
+template <int Order>
+void batchBenchmark(const vector<int>& base, const vector<int>& added, size_t batchSize) {
+    typedef BPlusTree<int, BPlusEmpty, Order> T;
+    auto ms = [](steady_clock::duration d) { return duration_cast<nanoseconds>(d).count() / 1e6; };
+    // Untuk n sangat kecil waktunya bisa 0; rasio tidak dicetak sebagai nan.
+    auto ratio = [](double single, double batch) {
+        if (batch <= 0) return string("-");
+        char buf[32];
+        snprintf(buf, sizeof buf, "%.2f", single / batch);
+        return string(buf);
+    };
+    vector<int> sortedBase(base);
+    sort(sortedBase.begin(), sortedBase.end());
+    sortedBase.erase(unique(sortedBase.begin(), sortedBase.end()), sortedBase.end());
+
+    T single, batched;
+    single.bulkLoad(sortedBase.begin(), sortedBase.end(), 0.7);
+    batched.bulkLoad(sortedBase.begin(), sortedBase.end(), 0.7);
+
+    auto start = steady_clock::now();
+    for (int v : added) single.insert(v);
+    double insertSingle = ms(steady_clock::now() - start);
+    start = steady_clock::now();
+    for (size_t i = 0; i < added.size(); i += batchSize) {
+        batched.insertBatch(added.begin() + i, added.begin() + min(added.size(), i + batchSize));
     }
-
-    if (cursor->keys.size() >= (ORDER - 1) / 2) return;
-
-    BPlusNode* parent = cursor->parent;
-    int index = -1;
-    for (int i = 0; i < parent->children.size(); i++) {
-        if (parent->children[i] == cursor) {
-            index = i;
-            break;
-        }
+    double insertBatched = ms(steady_clock::now() - start);
+
+    vector<int> removed(added.begin(), added.begin() + added.size() / 2);
+    start = steady_clock::now();
+    for (int v : removed) single.remove(v);
+    double eraseSingle = ms(steady_clock::now() - start);
+    start = steady_clock::now();
+    for (size_t i = 0; i < removed.size(); i += batchSize) {
+        batched.eraseBatch(removed.begin() + i, removed.begin() + min(removed.size(), i + batchSize));
     }
+    double eraseBatched = ms(steady_clock::now() - start);
 
-    BPlusNode* left = (index > 0) ? parent->children[index - 1] : nullptr;
-    BPlusNode* right = (index < parent->children.size() - 1) ? parent->children[index + 1] : nullptr;
+    cout << "Order " << setw(3) << Order << ": insert " << setw(9) << insertSingle << " ms vs batch " << setw(9)
+         << insertBatched << " ms (" << ratio(insertSingle, insertBatched) << "x), hapus " << setw(9) << eraseSingle
+         << " ms vs batch " << setw(9) << eraseBatched << " ms (" << ratio(eraseSingle, eraseBatched) << "x)"
+         << (single.size() == batched.size() ? "" : "  HASIL BERBEDA") << "\n";
+}
 
-    if (left && left->keys.size() > (ORDER - 1) / 2) {
-        cursor->keys.insert(cursor->keys.begin(), parent->keys[index - 1]);
-        parent->keys[index - 1] = left->keys.back();
-        cursor->children.insert(cursor->children.begin(), left->children.back());
-        left->children.pop_back();
-        left->keys.pop_back();
-    } else if (right && right->keys.size() > (ORDER - 1) / 2) {
-        cursor->keys.push_back(parent->keys[index]);
-        parent->keys[index] = right->keys.front();
-        cursor->children.push_back(right->children.front());
-        right->children.erase(right->children.begin());
-        right->keys.erase(right->keys.begin());
-    } else if (left) {
-        left->keys.push_back(parent->keys[index - 1]);
-        left->keys.insert(left->keys.end(), cursor->keys.begin(), cursor->keys.end());
-        left->children.insert(left->children.end(), cursor->children.begin(), cursor->children.end());
-        removeInternal(parent->keys[index - 1], parent, cursor);
-        delete cursor;
-    } else if (right) {
-        cursor->keys.push_back(parent->keys[index]);
-        cursor->keys.insert(cursor->keys.end(), right->keys.begin(), right->keys.end());
-        cursor->children.insert(cursor->children.end(), right->children.begin(), right->children.end());
-        removeInternal(parent->keys[index], parent, right);
-        delete right;
-    }
+int batchDemo(size_t n, size_t batchSize) {
+    mt19937 rng(7);
+    vector<int> base(n), added(n);
+    for (int& v : base) v = rng() & 0x7fffffff;
+    for (int& v : added) v = rng() & 0x7fffffff;
+    cout << fixed << setprecision(2);
+    cout << n << " key awal, " << n << " insert lalu " << n / 2 << " hapus, batch " << batchSize << " key\n";
+    batchBenchmark<4>(base, added, batchSize);
+    batchBenchmark<16>(base, added, batchSize);
+    batchBenchmark<64>(base, added, batchSize);
+    return 0;
 }
 
-void remove(int key) {
-    BPlusNode* cursor = root;
-    while (!cursor->isLeaf) {
-        bool found = false;
-        for (int i = 0; i < cursor->keys.size(); i++) {
-            if (key < cursor->keys[i]) {
-                cursor = cursor->children[i];
-                found = true;
-                break;
-            }
-        }
-        if (!found) cursor = cursor->children.back();
+// --wal: recovery dari <base>.bpt (snapshot) + <base>.wal (log), lalu
+// sisipkan key dari file (kalau ada) dan jalankan update/hapus contoh. Semua
+// mutasi masuk log, jadi tetap ada di run berikutnya.
+int walDemo(const string& base, const char* input, bool checkpointAfter) {
+    DurableTree tree(base + ".bpt", base + ".wal");
+    string error;
+    auto start = steady_clock::now();
+    if (!tree.open(&error)) {
+        cerr << "Error recovery " << base << ": " << error << endl;
+        return 1;
     }
-    auto it = find(cursor->keys.begin(), cursor->keys.end(), key);
-    if (it != cursor->keys.end()) {
-        cursor->keys.erase(it);
-        cout << "Hapus " << key << " berhasil.\n";
-        if (cursor == root || cursor->keys.size() >= (ORDER - 1) / 2) return;
-        removeInternal(0, cursor->parent, cursor);
-    } else {
-        cout << key << " tidak ditemukan.\n";
+    cout << "Recovery " << duration_cast<microseconds>(steady_clock::now() - start).count() << " us: "
+         << tree.size() << " key, " << tree.replayedRecords() << " record log di-replay, "
+         << tree.discardedBytes() << " byte ekor log rusak dibuang\n";
+
+    if (input) {
+        vector<int> values;
+        if (!readKeys(input, values)) return 1;
+        start = steady_clock::now();
+        size_t inserted = 0;
+        for (int v : values) inserted += tree.insert(v);
+        tree.commit();
+        cout << "Insert " << inserted << " key baru dalam "
+             << duration_cast<microseconds>(steady_clock::now() - start).count() << " us, "
+             << tree.syncs() << " fsync\n";
     }
-}
 
-void rangeQuery(int start, int end) {
-    BPlusNode* cursor = root;
-    while (cursor && !cursor->isLeaf) cursor = cursor->children[0];
-    while (cursor) {
-        for (int k : cursor->keys) {
-            if (k >= start && k <= end) cout << k << " ";
-        }
-        cursor = cursor->next;
+    update(tree, 1200, 15);
+    update(tree, 15, 8);
+    update(tree, 9999, 8);
+    remove(tree, 8);
+    remove(tree, 1324);
+    if (!tree.commit()) {
+        cerr << "Error menulis log " << base << ".wal\n";
+        return 1;
     }
-    cout << endl;
-}
-
-void display(BPlusNode* cursor) {
-    while (cursor && !cursor->isLeaf) cursor = cursor->children[0];
-    while (cursor) {
-        for (int key : cursor->keys) cout << key << " -> ";
-        cout << "NULL\n";
-        cursor = cursor->next;
+    if (checkpointAfter && !tree.checkpoint()) {
+        cerr << "Error checkpoint ke " << base << ".bpt\n";
+        return 1;
     }
+    cout << tree.size() << " key, LSN " << tree.lastLsn() << ", log " << tree.logBytes() << " byte, "
+         << tree.syncs() << " fsync, " << tree.checkpoints() << " checkpoint\n";
+    return 0;
 }
 
-void update(int oldKey, int newKey) {
-    int dummy = 0;
-    if (search(root, oldKey, &dummy)) {
-        if (search(root, newKey, &dummy)) {
-            cout << "Nilai sudah ada.\n";
-            return;
-        }
-        remove(oldKey);
-        insert(newKey);
-        cout << oldKey << " di update menjadi " << newKey << endl;
-    } else {
-        cout << oldKey << " tidak ditemukan.\n";
-    }
+// --parallel: bangun tree dari key acak (file atau n key acak) dengan
+// insert satu per satu, insertBatch, dan buildParallel 1..maxThreads thread.
+int parallelBuild(const char* source, unsigned maxThreads) {
+    vector<BuildStep> serial = {
+        {"insert satu per satu", [](const vector<int>& keys) {
+             Tree tree;
+             for (int k : keys) tree.insert(k);
+             return tree.size();
+         }},
+        {"insertBatch", [](const vector<int>& keys) {
+             Tree tree;
+             tree.insertBatch(keys.begin(), keys.end());
+             return tree.size();
+         }},
+    };
+    return parallelBuildBench(source, maxThreads, serial, [](const vector<int>& keys, unsigned t) {
+        Tree tree;
+        tree.buildParallel(keys.begin(), keys.end(), t);
+        return tree.size();
+    });
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        cerr << "Usage: " << argv[0] << " <filename.txt>\n";
+    if ((argc == 3 || argc == 4) && string(argv[1]) == "--wal") {
+        return walDemo(argv[2], argc == 4 ? argv[3] : nullptr, false);
+    }
+    if (argc == 3 && string(argv[1]) == "--checkpoint") {
+        return walDemo(argv[2], nullptr, true);
+    }
+    if ((argc == 3 || argc == 4) && string(argv[1]) == "--batch") {
+        // n dan ukuran batch: bilangan bulat 1..INT_MAX tanpa karakter sisa.
+        auto parseCount = [](const char* arg, long long& out) {
+            char* end;
+            out = strtoll(arg, &end, 10);
+            return end != arg && *end == '\0' && out >= 1 && out <= INT_MAX;
+        };
+        long long n, batchSize = 100000;
+        if (!parseCount(argv[2], n) || (argc == 4 && !parseCount(argv[3], batchSize))) {
+            cerr << "Usage: " << argv[0] << " --batch <n> [ukuran_batch]   (1 <= n, ukuran_batch <= " << INT_MAX
+                 << ")\n";
+            return 1;
+        }
+        return batchDemo((size_t)n, (size_t)batchSize);
+    }
+    if ((argc == 3 || argc == 4) && string(argv[1]) == "--parallel") {
+        unsigned threads;
+        if (!parseThreadCount(argc == 4 ? argv[3] : nullptr, threads)) {
+            cerr << "Usage: " << argv[0] << " --parallel <filename.txt|n> [threads]   (1 <= threads <= "
+                 << MAX_BENCH_THREADS << ")\n";
+            return 1;
+        }
+        return parallelBuild(argv[2], threads);
+    }
+    if (argc == 4 && string(argv[1]) == "--save") {
+        return saveIndex(argv[2], argv[3]);
+    }
+    if (argc >= 3 && string(argv[1]) == "--open") {
+        vector<int> keys;
+        for (int i = 3; i < argc; i++) keys.push_back(atoi(argv[i]));
+        if (keys.empty()) keys = {999999, 1};
+        return openIndex(argv[2], keys);
+    }
+    if (argc != 2 && argc != 3) {
+        cerr << "Usage: " << argv[0] << " <filename.txt> [fill_factor]\n";
+        cerr << "       " << argv[0] << " --save <filename.txt> <index.bpt>\n";
+        cerr << "       " << argv[0] << " --open <index.bpt> [key...]\n";
+        cerr << "       " << argv[0] << " --wal <base> [filename.txt]\n";
+        cerr << "       " << argv[0] << " --checkpoint <base>\n";
+        cerr << "       " << argv[0] << " --batch <n> [ukuran_batch]\n";
+        cerr << "       " << argv[0] << " --parallel <filename.txt|n> [threads]\n";
         return 1;
     }
-
-    ifstream file(argv[1]);
-    if (!file.is_open()) {
-        cerr << "Error membuka file " << argv[1] << endl;
+    double fillFactor = argc == 3 ? atof(argv[2]) : 1.0;
+    if (fillFactor <= 0 || fillFactor > 1) {
+        cerr << "fill_factor harus di antara 0 dan 1\n";
         return 1;
     }
 
-    int val;
-    while (file >> val) {
-        insert(val);
-    }
-    file.close();
+    Tree tree;
+    vector<int> values;
+    if (!readKeys(argv[1], values)) return 1;
+    buildTree(tree, values, fillFactor);
 
-    update(1200, 15);
-    update(15, 8);
-    update(9999, 8);
-    remove(8);
-    remove(1324);
+    update(tree, 1200, 15);
+    update(tree, 15, 8);
+    update(tree, 9999, 8);
+    remove(tree, 8);
+    remove(tree, 1324);
 
     cout << "B+ Tree:\n";
-    display(root);
+    tree.display();
 
     cout << "\nRange query (5 - 50): ";
-    rangeQuery(5, 50);
+    tree.rangeQuery(5, 50);
+    cout << "Jumlah key dalam range: " << tree.rangeCount(5, 50) << endl;
 
     int count = 0;
     int worst = 999999;
     auto start = high_resolution_clock::now();
-    bool found = search(root, worst, &count);
+    bool found = tree.search(worst, &count);
     auto end = high_resolution_clock::now();
     cout << "\nWorst Case: " << worst << "\n";
     cout << (found ? "Ditemukan" : "Tidak ditemukan") << " pada iterasi ke " << count << endl;
@@ -284,7 +332,7 @@ int main(int argc, char* argv[]) {
     count = 0;
     int best = 1;
     start = high_resolution_clock::now();
-    found = search(root, best, &count);
+    found = tree.search(best, &count);
     end = high_resolution_clock::now();
     cout << "\nBest Case: " << best << "\n";
     cout << (found ? "Ditemukan" : "Tidak ditemukan") << " pada iterasi ke " << count << endl;
@@ -0,0 +1,1135 @@
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "memory_stats.h"
+#include "node_pool.h"
+#include "node_search.h"
+#include "parallel_util.h"
+#include "value_storage.h"
+
+// Separator yang dinaikkan ke parent saat leaf dipecah: key apa pun s dengan
+// left < s <= right (menurut Compare tree) boleh dipakai. Default key pertama
+// leaf kanan; untuk string dengan urutan leksikografis (std::less) dipakai
+// prefix terpendek yang masih membedakan (suffix truncation), jadi node
+// internal menyimpan key yang lebih pendek. Compare lain memakai default,
+// karena prefix belum tentu terletak di antara left dan right.
+template <typename Key, typename Compare>
+const Key& separatorBetween(const Key&, const Key& right, const Compare&) {
+    return right;
+}
+
+inline std::string separatorBetween(const std::string& left, const std::string& right, const std::less<std::string>&) {
+    size_t common = 0;
+    while (common < left.size() && common < right.size() && left[common] == right[common]) common++;
+    return right.substr(0, common + 1);
+}
+
+inline std::string separatorBetween(const std::string& left, const std::string& right, const std::less<>&) {
+    return separatorBetween(left, right, std::less<std::string>());
+}
+
+// Rebalance: setiap remove menjaga leaf/internal minimal setengah penuh
+// (pinjam dari sibling atau merge). Lazy: remove hanya menghapus key dari
+// leaf; tree dipadatkan ulang sekaligus (compact) begitu fill factor leaf
+// turun di bawah batas.
+enum class BPlusDeleteMode { Rebalance, Lazy };
+
+// B+ tree generik. Order adalah jumlah maksimum anak per node internal;
+// node dipecah begitu jumlah key mencapai Order. Tidak ada state global,
+// jadi beberapa tree (dengan fanout berbeda) bisa hidup dalam satu proses.
+//
+// Key dan anak disimpan di array inline berkapasitas tetap (bukan vector),
+// node di-align ke cache line dan diambil dari NodePool milik tree. Value
+// kecil disimpan inline di leaf, value besar di heap (lihat value_storage.h).
+template <typename Key, typename Value = BPlusEmpty, int Order = 4,
+          typename Compare = std::less<Key>>
+class BPlusTree {
+    static_assert(Order >= 3, "Order B+ tree minimal 3");
+
+    struct Inner;
+
+    // Kapasitas Order (bukan Order - 1) supaya node boleh penuh sesaat
+    // sebelum dipecah, sama seperti algoritma split aslinya.
+    struct Node {
+        bool isLeaf;
+        int count;
+        Inner* parent;
+        Key keys[Order];
+
+        explicit Node(bool leaf) : isLeaf(leaf), count(0), parent(nullptr) {}
+    };
+
+    struct alignas(64) Leaf : Node {
+        ValueArray<Value, Order> values;
+        Leaf* next;
+
+        Leaf() : Node(true), next(nullptr) {}
+    };
+
+    struct alignas(64) Inner : Node {
+        Node* children[Order + 1];
+
+        Inner() : Node(false) {}
+    };
+
+    using Stored = typename std::conditional<std::is_same<Value, BPlusEmpty>::value, BPlusEmpty,
+                                             StoredValue<Value>>::type;
+
+public:
+    static constexpr size_t LEAF_BYTES = sizeof(Leaf);
+    static constexpr size_t INNER_BYTES = sizeof(Inner);
+
+    BPlusTree() = default;
+    explicit BPlusTree(Compare comp) : comp_(comp) {}
+    ~BPlusTree() { destroy(root_); }
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    bool insert(const Key& key, const Value& value = Value()) {
+        bool inserted;
+        insertOrAssign(key, value, false, inserted);
+        return inserted;
+    }
+
+    // Insert, atau timpa value kalau key sudah ada, dalam satu kali turun.
+    // Mengembalikan true kalau key baru disisipkan.
+    bool upsert(const Key& key, const Value& value) {
+        bool inserted;
+        insertOrAssign(key, value, true, inserted);
+        return inserted;
+    }
+
+    // Seperti upsert, tapi mengembalikan referensi ke value yang tersimpan.
+    // Referensi berlaku sampai operasi tulis berikutnya.
+    Value& put(const Key& key, const Value& value) {
+        bool inserted;
+        std::pair<Leaf*, int> at = insertOrAssign(key, value, true, inserted);
+        return loadValue(at.first->values[at.second]);
+    }
+
+    // Pointer ke value milik key, nullptr kalau tidak ada: cek keberadaan
+    // dan ambil data dalam satu kali turun.
+    Value* get(const Key& key) {
+        if (!root_) return nullptr;
+        Leaf* leaf = findLeaf(key);
+        int pos = lowerBound(leaf, key);
+        if (pos == leaf->count || !equal(leaf->keys[pos], key)) return nullptr;
+        return &loadValue(leaf->values[pos]);
+    }
+
+    const Value* get(const Key& key) const { return const_cast<BPlusTree*>(this)->get(key); }
+
+    // Hapus key; kalau `removed` diberikan, value-nya dipindah ke sana.
+    bool erase(const Key& key, Value* removed = nullptr) {
+        if (!root_) return false;
+        Leaf* cursor = findLeaf(key);
+        int pos = lowerBound(cursor, key);
+        if (pos == cursor->count || !equal(cursor->keys[pos], key)) return false;
+        if (removed) *removed = std::move(loadValue(cursor->values[pos]));
+        eraseAt(cursor, pos);
+        return true;
+    }
+
+    // Ganti oldKey menjadi newKey (value ikut pindah). Gagal kalau oldKey
+    // tidak ada atau newKey sudah ada. Kalau newKey masih jatuh di leaf yang
+    // sama, key ditulis ulang di tempat dengan menggeser entri di antaranya;
+    // selain itu hanya satu kali turun lagi untuk leaf tujuan, tanpa
+    // insert/remove penuh.
+    bool update(const Key& oldKey, const Key& newKey) {
+        if (!root_) return false;
+        Leaf* source = findLeaf(oldKey);
+        int from = lowerBound(source, oldKey);
+        if (from == source->count || !equal(source->keys[from], oldKey)) return false;
+        if (equal(oldKey, newKey)) return true;
+
+        // Separator kiri <= keys[0] dan keys[count-1] < separator kanan, jadi
+        // newKey di dalam rentang ini pasti milik leaf yang sama.
+        bool sameLeaf = !comp_(newKey, source->keys[0]) && !comp_(source->keys[source->count - 1], newKey);
+        Leaf* target = sameLeaf ? source : findLeaf(newKey);
+        int to = lowerBound(target, newKey);
+        if (to < target->count && equal(target->keys[to], newKey)) return false;
+
+        if (target == source) {
+            Stored value = std::move(source->values[from]);
+            if (to > from) {
+                to--;
+                for (int i = from; i < to; i++) {
+                    source->keys[i] = std::move(source->keys[i + 1]);
+                    source->values[i] = std::move(source->values[i + 1]);
+                }
+            } else {
+                for (int i = from; i > to; i--) {
+                    source->keys[i] = std::move(source->keys[i - 1]);
+                    source->values[i] = std::move(source->values[i - 1]);
+                }
+            }
+            source->keys[to] = newKey;
+            source->values[to] = std::move(value);
+            return true;
+        }
+
+        // Sisipkan di leaf tujuan dulu (split di sana tidak mengubah isi
+        // leaf asal), baru keluarkan dari leaf asal.
+        Stored value = std::move(source->values[from]);
+        insertAt(target, to, newKey, std::move(value));
+        eraseAt(source, from);
+        return true;
+    }
+
+    // Sisipkan sekumpulan key sekaligus (value Value(), atau valuesFirst[i]
+    // untuk key ke-i). Batch diurutkan lalu diterapkan leaf demi leaf: satu
+    // kali turun per leaf yang tersentuh, semua key milik leaf itu digabung
+    // bersamaan, dan leaf yang meluap dipecah sekali menjadi beberapa leaf.
+    // Key yang sudah ada, atau muncul lagi di batch, dilewati seperti insert
+    // biasa. Tree kosong langsung dibangun bottom-up. Mengembalikan jumlah
+    // key yang disisipkan.
+    template <typename It>
+    size_t insertBatch(It first, It last) {
+        std::vector<std::pair<Key, Stored>> batch;
+        batch.reserve(std::distance(first, last));
+        for (; first != last; ++first) batch.emplace_back(*first, Stored(Value()));
+        return insertSortedBatch(batch);
+    }
+
+    template <typename It, typename ValueIt>
+    size_t insertBatch(It first, It last, ValueIt valuesFirst) {
+        std::vector<std::pair<Key, Stored>> batch;
+        batch.reserve(std::distance(first, last));
+        for (size_t i = 0; first != last; ++first, ++i) batch.emplace_back(*first, Stored(valuesFirst[i]));
+        return insertSortedBatch(batch);
+    }
+
+    // Hapus sekumpulan key sekaligus: batch diurutkan, setiap leaf yang
+    // tersentuh didatangi sekali, key-nya dibuang dalam satu pass, lalu leaf
+    // dirapikan sekali (pinjam/merge sebanyak kekurangannya, atau cek compact
+    // sekali di akhir untuk mode Lazy). Mengembalikan jumlah key yang dihapus.
+    template <typename It>
+    size_t eraseBatch(It first, It last) {
+        std::vector<Key> batch(first, last);
+        std::sort(batch.begin(), batch.end(), comp_);
+        batch.erase(std::unique(batch.begin(), batch.end(),
+                                [&](const Key& a, const Key& b) { return equal(a, b); }),
+                    batch.end());
+
+        size_t removed = 0;
+        for (size_t i = 0; i < batch.size() && root_;) {
+            const Key* upper;
+            Leaf* leaf = findLeaf(batch[i], &upper);
+            size_t j = i + 1;
+            while (j < batch.size() && (!upper || comp_(batch[j], *upper))) j++;
+            removed += eraseFromLeaf(leaf, batch.data() + i, j - i);
+            i = j;
+        }
+        if (deleteMode_ == BPlusDeleteMode::Lazy && removed > 0) {
+            size_t leafSlots = leafPool_.liveNodes() * (Order - 1);
+            if (size_ < leafSlots * compactBelow_) compact();
+        }
+        return removed;
+    }
+
+    // `count` (opsional) bertambah sebanyak key leaf yang akan diperiksa
+    // scan linear sampai key ditemukan (atau seluruh leaf kalau tidak ada).
+    bool search(const Key& key, int* count = nullptr) const {
+        if (!root_) return false;
+        const Leaf* cursor = findLeaf(key);
+        int pos = lowerBound(cursor, key);
+        bool found = pos < cursor->count && equal(cursor->keys[pos], key);
+        if (count) *count += found ? pos + 1 : cursor->count;
+        return found;
+    }
+
+    // Cari n key sekaligus; found[i] diisi hasil untuk keys[i]. Satu grup key
+    // turun bersama level demi level (semua leaf ada di kedalaman yang sama):
+    // anak berikutnya untuk setiap key di-prefetch dulu, baru dibaca di
+    // putaran berikutnya, jadi cache miss node antar key saling tumpang tindih.
+    void searchBatch(const Key* keys, size_t n, bool* found) const {
+        if (!root_) {
+            std::fill(found, found + n, false);
+            return;
+        }
+        const Node* cursor[BATCH_GROUP];
+        for (size_t base = 0; base < n; base += BATCH_GROUP) {
+            size_t g = std::min(BATCH_GROUP, n - base);
+            for (size_t i = 0; i < g; i++) cursor[i] = root_;
+            while (!cursor[0]->isLeaf) {
+                for (size_t i = 0; i < g; i++) {
+                    const Inner* inner = static_cast<const Inner*>(cursor[i]);
+                    cursor[i] = inner->children[upperBound(inner, keys[base + i])];
+                    prefetchNode(cursor[i]);
+                }
+            }
+            for (size_t i = 0; i < g; i++) {
+                const Leaf* leaf = static_cast<const Leaf*>(cursor[i]);
+                int pos = lowerBound(leaf, keys[base + i]);
+                found[base + i] = pos < leaf->count && equal(leaf->keys[pos], keys[base + i]);
+            }
+        }
+    }
+
+    bool remove(const Key& key) { return erase(key); }
+
+    // Lazy: leaf boleh kurus atau kosong setelah remove, dan tree dibangun
+    // ulang penuh (compact) begitu jumlah key < compactBelow x kapasitas
+    // leaf. Cocok untuk workload yang banyak delete.
+    void setDeleteMode(BPlusDeleteMode mode, double compactBelow = 0.4) {
+        deleteMode_ = mode;
+        compactBelow_ = compactBelow;
+    }
+
+    BPlusDeleteMode deleteMode() const { return deleteMode_; }
+
+    // Bangun ulang tree bottom-up dari isinya sendiri: leaf terisi sesuai
+    // fillFactor, rantai next dan separator baru. O(N).
+    void compact(double fillFactor = 1.0) {
+        std::vector<Key> keys;
+        std::vector<Stored> values;
+        keys.reserve(size_);
+        if constexpr (!std::is_same<Value, BPlusEmpty>::value) values.reserve(size_);
+        Node* cursor = root_;
+        while (cursor && !cursor->isLeaf) cursor = static_cast<Inner*>(cursor)->children[0];
+        for (Leaf* leaf = static_cast<Leaf*>(cursor); leaf; leaf = leaf->next) {
+            for (int i = 0; i < leaf->count; i++) {
+                keys.push_back(std::move(leaf->keys[i]));
+                if constexpr (!std::is_same<Value, BPlusEmpty>::value) values.push_back(std::move(leaf->values[i]));
+            }
+        }
+        destroy(root_);
+        root_ = nullptr;
+        size_ = 0;
+        buildSorted(keys.begin(), keys.size(), fillFactor, [&](size_t i) -> Stored {
+            if constexpr (std::is_same<Value, BPlusEmpty>::value) {
+                return Stored();
+            } else {
+                return std::move(values[i]);
+            }
+        });
+    }
+
+    // Panggil fn(key, value) (atau fn(key)) untuk setiap key di [start, end]
+    // secara terurut. Scan mulai dari leaf yang memuat start dan berhenti di
+    // end, jadi biayanya O(log N + K). `offset` key pertama dilewati (leaf
+    // yang seluruhnya terlewati tidak dibaca per key) dan paling banyak
+    // `limit` key dikirim. Kalau fn mengembalikan bool, false menghentikan
+    // scan. Mengembalikan jumlah key yang dikirim ke fn.
+    template <typename Fn>
+    size_t scan(const Key& start, const Key& end, Fn&& fn, size_t offset = 0,
+                size_t limit = SIZE_MAX) const {
+        if (!root_ || comp_(end, start)) return 0;
+        const Leaf* leaf = findLeaf(start);
+        int pos = lowerBound(leaf, start);
+        size_t delivered = 0;
+        while (leaf && delivered < limit) {
+            int stop = leaf->count;
+            bool last = stop > 0 && comp_(end, leaf->keys[stop - 1]);
+            if (last) stop = upperBound(leaf, end);
+
+            size_t avail = stop > pos ? stop - pos : 0;
+            if (offset >= avail) {
+                offset -= avail;
+            } else {
+                pos += offset;
+                offset = 0;
+                for (; pos < stop && delivered < limit; pos++) {
+                    delivered++;
+                    if (!emit(fn, leaf->keys[pos], loadValue(leaf->values[pos]))) return delivered;
+                }
+            }
+            if (last) break;
+            leaf = leaf->next;
+            pos = 0;
+        }
+        return delivered;
+    }
+
+    // Jumlah key di [start, end] tanpa membaca key satu per satu.
+    size_t rangeCount(const Key& start, const Key& end) const {
+        if (!root_ || comp_(end, start)) return 0;
+        const Leaf* leaf = findLeaf(start);
+        int pos = lowerBound(leaf, start);
+        size_t total = 0;
+        for (; leaf; leaf = leaf->next, pos = 0) {
+            if (leaf->count > 0 && comp_(end, leaf->keys[leaf->count - 1])) {
+                int stop = upperBound(leaf, end);
+                return total + (stop > pos ? stop - pos : 0);
+            }
+            total += leaf->count - pos;
+        }
+        return total;
+    }
+
+    void rangeQuery(const Key& start, const Key& end, std::ostream& out = std::cout) const {
+        scan(start, end, [&](const Key& k) { out << k << " "; });
+        out << std::endl;
+    }
+
+    // Iterator maju di sepanjang rantai leaf.
+    class Iterator {
+    public:
+        Iterator() = default;
+
+        bool valid() const { return leaf_ != nullptr; }
+        const Key& key() const { return leaf_->keys[pos_]; }
+        const Value& value() const { return loadValue(leaf_->values[pos_]); }
+
+        Iterator& operator++() {
+            pos_++;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return leaf_ == other.leaf_ && pos_ == other.pos_; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class BPlusTree;
+
+        Iterator(const Leaf* leaf, int pos) : leaf_(leaf), pos_(pos) { skipEmpty(); }
+
+        void skipEmpty() {
+            while (leaf_ && pos_ >= leaf_->count) {
+                leaf_ = leaf_->next;
+                pos_ = 0;
+            }
+        }
+
+        const Leaf* leaf_ = nullptr;
+        int pos_ = 0;
+    };
+
+    Iterator begin() const { return Iterator(leftmostLeaf(), 0); }
+    Iterator end() const { return Iterator(); }
+
+    // Iterator ke entri key, end() kalau tidak ada. Bisa dilanjutkan dengan
+    // ++ untuk membaca key-key sesudahnya.
+    Iterator find(const Key& key) const {
+        if (!root_) return end();
+        const Leaf* leaf = findLeaf(key);
+        int pos = lowerBound(leaf, key);
+        if (pos == leaf->count || !equal(leaf->keys[pos], key)) return end();
+        return Iterator(leaf, pos);
+    }
+
+    // Iterator ke key pertama yang >= key.
+    Iterator seek(const Key& key) const {
+        if (!root_) return end();
+        const Leaf* leaf = findLeaf(key);
+        return Iterator(leaf, lowerBound(leaf, key));
+    }
+
+    void display(std::ostream& out = std::cout) const {
+        for (const Leaf* cursor = leftmostLeaf(); cursor; cursor = cursor->next) {
+            for (int i = 0; i < cursor->count; i++) out << cursor->keys[i] << " -> ";
+            out << "NULL\n";
+        }
+    }
+
+    // Bangun tree bottom-up dari key yang sudah terurut naik dan unik, dalam
+    // satu pass: leaf diisi penuh sesuai fillFactor (0 < fillFactor <= 1),
+    // lalu level internal disusun di atasnya. Hanya untuk tree kosong;
+    // mengembalikan false kalau tree tidak kosong atau input tidak terurut.
+    template <typename It>
+    bool bulkLoad(It first, It last, double fillFactor = 1.0) {
+        if (root_) return false;
+        for (It prev = first, it = first; it != last; prev = it, ++it) {
+            if (it != first && !comp_(*prev, *it)) return false;
+        }
+        buildSorted(first, std::distance(first, last), fillFactor, [](size_t) { return Value(); });
+        return true;
+    }
+
+    // Seperti bulkLoad di atas, dengan value ke-i diambil dari valuesFirst[i].
+    template <typename It, typename ValueIt>
+    bool bulkLoad(It first, It last, ValueIt valuesFirst, double fillFactor) {
+        if (root_) return false;
+        for (It prev = first, it = first; it != last; prev = it, ++it) {
+            if (it != first && !comp_(*prev, *it)) return false;
+        }
+        buildSorted(first, std::distance(first, last), fillFactor,
+                    [&](size_t i) -> Value { return valuesFirst[i]; });
+        return true;
+    }
+
+    // Bangun tree kosong dari key sembarang urutan (boleh duplikat, value
+    // Value()) dengan `threads` thread: sort paralel, buang duplikat paralel,
+    // lalu leaf diisi bersamaan per rentang key dan level internal disusun
+    // level demi level seperti bulkLoad. Hanya untuk tree kosong;
+    // mengembalikan false kalau tree tidak kosong.
+    template <typename It>
+    bool buildParallel(It first, It last, unsigned threads, double fillFactor = 1.0) {
+        if (root_) return false;
+        threads = std::max(1u, threads);
+        std::vector<Key> keys(first, last);
+        parallelSort(keys, comp_, threads);
+        parallelUnique(keys, [&](const Key& a, const Key& b) { return !comp_(a, b); }, threads);
+        buildSorted(keys.begin(), keys.size(), fillFactor, [](size_t) { return Value(); }, threads);
+        return true;
+    }
+
+    bool empty() const { return root_ == nullptr; }
+    size_t size() const { return size_; }
+
+    // Telusuri semua node: byte pool (termasuk slot pool yang belum dipakai),
+    // pointer parent/next/anak, dan slot key kosong di setiap node. Fill
+    // factor dihitung terhadap kapasitas leaf (Order - 1 key per leaf).
+    MemoryStats memoryStats() const {
+        MemoryStats m;
+        m.keys = size_;
+        m.totalBytes = leafPool_.reservedBytes() + innerPool_.reservedBytes();
+        m.slackBytes = m.totalBytes - leafPool_.liveNodes() * sizeof(Leaf) -
+                       innerPool_.liveNodes() * sizeof(Inner);
+        std::vector<const Node*> stack;
+        if (root_) stack.push_back(root_);
+        while (!stack.empty()) {
+            const Node* node = stack.back();
+            stack.pop_back();
+            m.nodes++;
+            for (int i = 0; i < node->count; i++) m.keyHeapBytes += ownedHeapBytes(node->keys[i]);
+            m.slackBytes += (Order - node->count) * sizeof(Key);
+            if (node->isLeaf) {
+                const Leaf* leaf = static_cast<const Leaf*>(node);
+                m.leaves++;
+                m.keySlots += Order - 1;
+                m.pointerBytes += sizeof(leaf->parent) + sizeof(leaf->next);
+                if constexpr (!std::is_same<Value, BPlusEmpty>::value) {
+                    for (int i = 0; i < leaf->count; i++) m.keyHeapBytes += ownedHeapBytes(leaf->values[i]);
+                    m.slackBytes += (Order - leaf->count) * sizeof(Stored);
+                }
+            } else {
+                const Inner* inner = static_cast<const Inner*>(node);
+                m.pointerBytes += sizeof(inner->parent) + sizeof(inner->children);
+                for (int i = 0; i <= inner->count; i++) stack.push_back(inner->children[i]);
+            }
+        }
+        m.totalBytes += m.keyHeapBytes;
+        return m;
+    }
+
+private:
+    Node* root_ = nullptr;
+    size_t size_ = 0;
+    Compare comp_;
+    NodePool<Leaf> leafPool_;
+    NodePool<Inner> innerPool_;
+    BPlusDeleteMode deleteMode_ = BPlusDeleteMode::Rebalance;
+    double compactBelow_ = 0.4;
+
+    // Jumlah key minimum node non-root setelah remove (mode Rebalance).
+    static constexpr int MIN_KEYS = (Order - 1) / 2;
+
+    static constexpr size_t BATCH_GROUP = 16;
+
+    // Paling sedikit sekian node per thread saat membangun paralel; di bawah
+    // itu ongkos membuat thread lebih mahal dari pekerjaannya.
+    static constexpr size_t LEAVES_PER_THREAD = 1024;
+
+    bool equal(const Key& a, const Key& b) const {
+        return !comp_(a, b) && !comp_(b, a);
+    }
+
+    // Header dan array key node (yang dibaca saat mencari), per cache line.
+    static void prefetchNode(const Node* node) {
+        const char* p = reinterpret_cast<const char*>(node);
+        for (size_t off = 0; off < sizeof(Node); off += 64) __builtin_prefetch(p + off);
+    }
+
+    // Inti bulkLoad/compact/buildParallel: n key terurut unik dari `first`,
+    // value ke-i dari valueOf(i). Tree harus kosong. Node diambil dari pool
+    // secara serial (pool tidak thread-safe), lalu isinya dibagi per rentang
+    // ke `threads` thread: setiap leaf tahu rentang key-nya dari index saja,
+    // dan setiap level internal baru dikerjakan setelah level di bawahnya
+    // selesai. valueOf harus aman dipanggil bersamaan untuk index berbeda.
+    template <typename It, typename ValueFn>
+    void buildSorted(It first, size_t n, double fillFactor, ValueFn valueOf, unsigned threads = 1) {
+        if (n == 0) return;
+
+        // Leaf menampung paling banyak Order - 1 key, internal Order anak.
+        int leafTarget = std::max(1, std::min(Order - 1, (int)(fillFactor * (Order - 1) + 0.5)));
+        int innerTarget = std::max(2, std::min(Order, (int)(fillFactor * Order + 0.5)));
+
+        // Sebar key merata supaya leaf terakhir tidak kurus: leaf i mulai di
+        // key ke-start(i) dan mengambil n / leafCount key, +1 untuk sisa.
+        size_t leafCount = (n + leafTarget - 1) / leafTarget;
+        auto leafStart = [&](size_t i) { return i * (n / leafCount) + std::min(i, n % leafCount); };
+
+        std::vector<Node*> level(leafCount);
+        std::vector<Key> minKeys(leafCount);  // batas bawah tiap subtree, jadi separator
+        for (size_t i = 0; i < leafCount; i++) level[i] = leafPool_.create();
+
+        parallelFor(threads, leafCount, [&](size_t lo, size_t hi) {
+            It it = std::next(first, leafStart(lo));
+            for (size_t i = lo; i < hi; i++) {
+                Leaf* leaf = static_cast<Leaf*>(level[i]);
+                size_t idx = leafStart(i);
+                int take = leafStart(i + 1) - idx;
+                for (int j = 0; j < take; j++, ++it, ++idx) {
+                    leaf->keys[j] = *it;
+                    leaf->values[j] = valueOf(idx);
+                }
+                leaf->count = take;
+                leaf->next = i + 1 < leafCount ? static_cast<Leaf*>(level[i + 1]) : nullptr;
+            }
+        }, LEAVES_PER_THREAD);
+        // Separator butuh leaf tetangga yang sudah terisi, jadi pass terpisah.
+        parallelFor(threads, leafCount, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; i++) {
+                const Leaf* leaf = static_cast<Leaf*>(level[i]);
+                if (i == 0) {
+                    minKeys[i] = leaf->keys[0];
+                } else {
+                    const Leaf* prev = static_cast<Leaf*>(level[i - 1]);
+                    minKeys[i] = separatorBetween(prev->keys[prev->count - 1], leaf->keys[0], comp_);
+                }
+            }
+        }, LEAVES_PER_THREAD);
+
+        while (level.size() > 1) {
+            size_t childCount = level.size();
+            // Setiap node internal minimal punya dua anak.
+            size_t parentCount = std::max<size_t>(1, std::min((childCount + innerTarget - 1) / innerTarget,
+                                                              childCount / 2));
+            auto childStart = [&](size_t i) {
+                return i * (childCount / parentCount) + std::min(i, childCount % parentCount);
+            };
+            std::vector<Node*> parents(parentCount);
+            std::vector<Key> parentMins(parentCount);
+            for (size_t i = 0; i < parentCount; i++) parents[i] = innerPool_.create();
+
+            parallelFor(threads, parentCount, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; i++) {
+                    Inner* inner = static_cast<Inner*>(parents[i]);
+                    size_t c = childStart(i);
+                    int take = childStart(i + 1) - c;
+                    for (int j = 0; j < take; j++) {
+                        inner->children[j] = level[c + j];
+                        level[c + j]->parent = inner;
+                        if (j > 0) inner->keys[j - 1] = minKeys[c + j];
+                    }
+                    inner->count = take - 1;
+                    parentMins[i] = std::move(minKeys[c]);
+                }
+            }, LEAVES_PER_THREAD);
+            level.swap(parents);
+            minKeys.swap(parentMins);
+        }
+
+        root_ = level[0];
+        size_ = n;
+    }
+
+    // Key int dengan urutan bawaan memakai kernel SIMD dari node_search.h.
+    static constexpr bool SIMD_KEYS =
+        std::is_same<Key, int>::value && std::is_same<Compare, std::less<int>>::value;
+
+    // Posisi key pertama yang lebih besar dari `key`; di node internal ini
+    // sekaligus index anak yang harus diikuti.
+    int upperBound(const Node* node, const Key& key) const {
+        if constexpr (SIMD_KEYS) {
+            return nodeUpperBound(node->keys, node->count, key);
+        } else {
+            int n = node->count;
+            for (int i = 0; i < n; i++) {
+                if (comp_(key, node->keys[i])) return i;
+            }
+            return n;
+        }
+    }
+
+    int lowerBound(const Node* node, const Key& key) const {
+        if constexpr (SIMD_KEYS) {
+            return nodeLowerBound(node->keys, node->count, key);
+        } else {
+            return std::lower_bound(node->keys, node->keys + node->count, key, comp_) - node->keys;
+        }
+    }
+
+    Leaf* findLeaf(const Key& key) const {
+        Node* cursor = root_;
+        while (!cursor->isLeaf) {
+            cursor = static_cast<Inner*>(cursor)->children[upperBound(cursor, key)];
+        }
+        return static_cast<Leaf*>(cursor);
+    }
+
+    // Seperti findLeaf; *upper diisi separator terdekat di kanan leaf (semua
+    // key leaf < *upper), nullptr untuk leaf paling kanan. Pointer menunjuk
+    // ke node internal, jadi hanya berlaku sampai tree diubah.
+    Leaf* findLeaf(const Key& key, const Key** upper) const {
+        *upper = nullptr;
+        Node* cursor = root_;
+        while (!cursor->isLeaf) {
+            int idx = upperBound(cursor, key);
+            if (idx < cursor->count) *upper = &cursor->keys[idx];
+            cursor = static_cast<Inner*>(cursor)->children[idx];
+        }
+        return static_cast<Leaf*>(cursor);
+    }
+
+    template <typename Fn>
+    static bool emit(Fn& fn, const Key& key, const Value& value) {
+        if constexpr (std::is_invocable<Fn&, const Key&, const Value&>::value) {
+            if constexpr (std::is_same<decltype(fn(key, value)), bool>::value) {
+                return fn(key, value);
+            } else {
+                fn(key, value);
+                return true;
+            }
+        } else {
+            if constexpr (std::is_same<decltype(fn(key)), bool>::value) {
+                return fn(key);
+            } else {
+                fn(key);
+                return true;
+            }
+        }
+    }
+
+    const Leaf* leftmostLeaf() const {
+        Node* cursor = root_;
+        while (cursor && !cursor->isLeaf) cursor = static_cast<Inner*>(cursor)->children[0];
+        return static_cast<const Leaf*>(cursor);
+    }
+
+    // Turun satu kali ke leaf untuk key. Kalau key belum ada, sisipkan
+    // (split kalau penuh); kalau sudah ada, timpa value-nya hanya jika
+    // `assign`. `inserted` menandai key baru. Mengembalikan leaf dan posisi
+    // entri untuk key (baru atau lama).
+    std::pair<Leaf*, int> insertOrAssign(const Key& key, const Value& value, bool assign, bool& inserted) {
+        inserted = true;
+        if (!root_) {
+            Leaf* leaf = leafPool_.create();
+            leaf->keys[0] = key;
+            leaf->values[0] = value;
+            leaf->count = 1;
+            root_ = leaf;
+            size_++;
+            return {leaf, 0};
+        }
+
+        Leaf* cursor = findLeaf(key);
+        int pos = lowerBound(cursor, key);
+        if (pos < cursor->count && equal(cursor->keys[pos], key)) {
+            if (assign) cursor->values[pos] = value;
+            inserted = false;
+            return {cursor, pos};
+        }
+        return insertAt(cursor, pos, key, value);
+    }
+
+    // Sisipkan di posisi yang sudah diketahui, lalu split kalau leaf penuh.
+    // Mengembalikan letak entri setelah split.
+    std::pair<Leaf*, int> insertAt(Leaf* cursor, int pos, const Key& key, Stored value) {
+        for (int i = cursor->count; i > pos; i--) {
+            cursor->keys[i] = std::move(cursor->keys[i - 1]);
+            cursor->values[i] = std::move(cursor->values[i - 1]);
+        }
+        cursor->keys[pos] = key;
+        cursor->values[pos] = std::move(value);
+        cursor->count++;
+        size_++;
+
+        if (cursor->count >= Order) {
+            Leaf* newLeaf = leafPool_.create();
+            int mid = (Order + 1) / 2;
+            for (int i = mid; i < cursor->count; i++) {
+                newLeaf->keys[i - mid] = std::move(cursor->keys[i]);
+                newLeaf->values[i - mid] = std::move(cursor->values[i]);
+            }
+            newLeaf->count = cursor->count - mid;
+            cursor->count = mid;
+            newLeaf->next = cursor->next;
+            cursor->next = newLeaf;
+            insertIntoParent(cursor, separatorBetween(cursor->keys[mid - 1], newLeaf->keys[0], comp_), newLeaf);
+            if (pos >= mid) return {newLeaf, pos - mid};
+        }
+        return {cursor, pos};
+    }
+
+    // Hapus entri di posisi yang sudah diketahui, lalu rebalance (atau
+    // compact di mode Lazy).
+    void eraseAt(Leaf* cursor, int pos) {
+        for (int i = pos; i < cursor->count - 1; i++) {
+            cursor->keys[i] = std::move(cursor->keys[i + 1]);
+            cursor->values[i] = std::move(cursor->values[i + 1]);
+        }
+        cursor->count--;
+        size_--;
+
+        if (deleteMode_ == BPlusDeleteMode::Lazy) {
+            size_t leafSlots = leafPool_.liveNodes() * (Order - 1);
+            if (size_ < leafSlots * compactBelow_) compact();
+            return;
+        }
+        if (cursor == root_) {
+            if (cursor->count == 0) {
+                leafPool_.destroy(cursor);
+                root_ = nullptr;
+            }
+            return;
+        }
+        if (cursor->count < MIN_KEYS) rebalanceLeaf(cursor);
+    }
+
+    // Inti insertBatch. Entri diurutkan stabil dan hanya kemunculan pertama
+    // tiap key yang dipakai, jadi hasilnya sama dengan insert berurutan.
+    size_t insertSortedBatch(std::vector<std::pair<Key, Stored>>& batch) {
+        std::stable_sort(batch.begin(), batch.end(),
+                         [&](const std::pair<Key, Stored>& a, const std::pair<Key, Stored>& b) {
+                             return comp_(a.first, b.first);
+                         });
+        batch.erase(std::unique(batch.begin(), batch.end(),
+                                [&](const std::pair<Key, Stored>& a, const std::pair<Key, Stored>& b) {
+                                    return equal(a.first, b.first);
+                                }),
+                    batch.end());
+
+        if (!root_) {
+            std::vector<Key> keys;
+            keys.reserve(batch.size());
+            for (auto& e : batch) keys.push_back(std::move(e.first));
+            buildSorted(keys.begin(), keys.size(), 1.0, [&](size_t i) -> Stored { return std::move(batch[i].second); });
+            return size_;
+        }
+
+        size_t inserted = 0;
+        std::vector<Key> keyBuf;
+        std::vector<Stored> valueBuf;
+        for (size_t i = 0; i < batch.size();) {
+            const Key* upper;
+            Leaf* leaf = findLeaf(batch[i].first, &upper);
+            size_t j = i + 1;
+            while (j < batch.size() && (!upper || comp_(batch[j].first, *upper))) j++;
+            inserted += mergeIntoLeaf(leaf, batch.data() + i, j - i, keyBuf, valueBuf);
+            i = j;
+        }
+        return inserted;
+    }
+
+    // Gabungkan r entri terurut unik yang semuanya milik `leaf`; key yang
+    // sudah ada dilewati. Kalau hasilnya muat, digabung di tempat dari
+    // belakang. Kalau tidak, isi gabungan dibagi rata ke leaf sebanyak yang
+    // perlu dan separator-nya dipasang ke parent satu per satu.
+    size_t mergeIntoLeaf(Leaf* leaf, std::pair<Key, Stored>* entries, size_t r, std::vector<Key>& keyBuf,
+                         std::vector<Stored>& valueBuf) {
+        // Batch yang jarang (satu key per leaf) memakai jalur insert biasa.
+        int start = lowerBound(leaf, entries[0].first);
+        if (r == 1) {
+            if (start < leaf->count && equal(leaf->keys[start], entries[0].first)) return 0;
+            insertAt(leaf, start, entries[0].first, std::move(entries[0].second));
+            return 1;
+        }
+
+        size_t fresh = 0;
+        for (size_t b = 0, a = start; b < r; b++) {
+            while ((int)a < leaf->count && comp_(leaf->keys[a], entries[b].first)) a++;
+            if ((int)a == leaf->count || comp_(entries[b].first, leaf->keys[a])) fresh++;
+        }
+        if (fresh == 0) return 0;
+        size_ += fresh;
+        size_t total = leaf->count + fresh;
+
+        if (total < (size_t)Order) {
+            int w = total - 1, a = leaf->count - 1;
+            for (size_t b = r; b-- > 0 && w != a;) {
+                const Key& key = entries[b].first;
+                for (; a >= 0 && comp_(key, leaf->keys[a]); a--, w--) {
+                    leaf->keys[w] = std::move(leaf->keys[a]);
+                    leaf->values[w] = std::move(leaf->values[a]);
+                }
+                if (a >= 0 && !comp_(leaf->keys[a], key)) continue;
+                leaf->keys[w] = std::move(entries[b].first);
+                leaf->values[w] = std::move(entries[b].second);
+                w--;
+            }
+            leaf->count = total;
+            return fresh;
+        }
+
+        keyBuf.clear();
+        valueBuf.clear();
+        int a = 0;
+        for (size_t b = 0; b < r; b++) {
+            for (; a < leaf->count && comp_(leaf->keys[a], entries[b].first); a++) {
+                keyBuf.push_back(std::move(leaf->keys[a]));
+                valueBuf.push_back(std::move(leaf->values[a]));
+            }
+            if (a < leaf->count && !comp_(entries[b].first, leaf->keys[a])) continue;
+            keyBuf.push_back(std::move(entries[b].first));
+            valueBuf.push_back(std::move(entries[b].second));
+        }
+        for (; a < leaf->count; a++) {
+            keyBuf.push_back(std::move(leaf->keys[a]));
+            valueBuf.push_back(std::move(leaf->values[a]));
+        }
+
+        size_t parts = (total + Order - 2) / (Order - 1);
+        size_t pos = 0;
+        Leaf* prev = nullptr;
+        for (size_t p = 0; p < parts; p++) {
+            Leaf* cursor = leaf;
+            if (prev) {
+                cursor = leafPool_.create();
+                cursor->next = prev->next;
+                prev->next = cursor;
+            }
+            int take = total / parts + (p < total % parts ? 1 : 0);
+            for (int t = 0; t < take; t++, pos++) {
+                cursor->keys[t] = std::move(keyBuf[pos]);
+                cursor->values[t] = std::move(valueBuf[pos]);
+            }
+            cursor->count = take;
+            if (prev) insertIntoParent(prev, separatorBetween(prev->keys[prev->count - 1], cursor->keys[0], comp_), cursor);
+            prev = cursor;
+        }
+        return fresh;
+    }
+
+    // Buang r key terurut unik dari `leaf` dalam satu pass, lalu rebalance
+    // sekali. Mode Lazy tidak merapikan di sini (lihat eraseBatch).
+    size_t eraseFromLeaf(Leaf* leaf, const Key* keys, size_t r) {
+        int w = lowerBound(leaf, keys[0]);
+        if (r == 1) {
+            if (w == leaf->count || !equal(leaf->keys[w], keys[0])) return 0;
+            eraseAt(leaf, w);
+            return 1;
+        }
+
+        size_t b = 0;
+        for (int a = w; a < leaf->count; a++) {
+            while (b < r && comp_(keys[b], leaf->keys[a])) b++;
+            if (b < r && !comp_(leaf->keys[a], keys[b])) {
+                b++;
+                continue;
+            }
+            if (w != a) {
+                leaf->keys[w] = std::move(leaf->keys[a]);
+                leaf->values[w] = std::move(leaf->values[a]);
+            }
+            w++;
+        }
+        size_t gone = leaf->count - w;
+        leaf->count = w;
+        size_ -= gone;
+
+        if (gone == 0 || deleteMode_ == BPlusDeleteMode::Lazy) return gone;
+        if (leaf == root_) {
+            if (leaf->count == 0) {
+                leafPool_.destroy(leaf);
+                root_ = nullptr;
+            }
+            return gone;
+        }
+        if (leaf->count < MIN_KEYS) rebalanceLeaf(leaf);
+        return gone;
+    }
+
+    // Pasang `right` (hasil split `left`) ke parent dengan separator `key`.
+    void insertIntoParent(Node* left, const Key& key, Node* right) {
+        if (left == root_) {
+            Inner* newRoot = innerPool_.create();
+            newRoot->keys[0] = key;
+            newRoot->children[0] = left;
+            newRoot->children[1] = right;
+            newRoot->count = 1;
+            left->parent = newRoot;
+            right->parent = newRoot;
+            root_ = newRoot;
+        } else {
+            right->parent = left->parent;
+            insertInternal(key, left->parent, right);
+        }
+    }
+
+    void insertInternal(const Key& key, Inner* cursor, Node* child) {
+        int index = std::upper_bound(cursor->keys, cursor->keys + cursor->count, key, comp_) - cursor->keys;
+        for (int i = cursor->count; i > index; i--) {
+            cursor->keys[i] = std::move(cursor->keys[i - 1]);
+            cursor->children[i + 1] = cursor->children[i];
+        }
+        cursor->keys[index] = key;
+        cursor->children[index + 1] = child;
+        cursor->count++;
+
+        if (cursor->count >= Order) {
+            Inner* newInternal = innerPool_.create();
+            int mid = Order / 2;
+
+            for (int i = mid + 1; i < cursor->count; i++) {
+                newInternal->keys[i - mid - 1] = std::move(cursor->keys[i]);
+            }
+            for (int i = mid + 1; i <= cursor->count; i++) {
+                newInternal->children[i - mid - 1] = cursor->children[i];
+                cursor->children[i]->parent = newInternal;
+            }
+            newInternal->count = cursor->count - mid - 1;
+            Key upKey = std::move(cursor->keys[mid]);
+            cursor->count = mid;
+
+            insertIntoParent(cursor, upKey, newInternal);
+        }
+    }
+
+    static int childIndex(const Inner* parent, const Node* child) {
+        int index = 0;
+        while (parent->children[index] != child) index++;
+        return index;
+    }
+
+    // Leaf non-root yang kurang dari MIN_KEYS: pinjam kekurangannya dari
+    // sibling (kiri dulu) kalau sibling tetap di atas minimum sesudahnya,
+    // selain itu gabung dengan sibling. Setelah remove biasa kekurangannya
+    // satu key; eraseBatch bisa meninggalkan leaf yang jauh lebih kurus.
+    // Separator parent ikut diperbarui.
+    void rebalanceLeaf(Leaf* leaf) {
+        Inner* parent = leaf->parent;
+        int index = childIndex(parent, leaf);
+        Leaf* left = index > 0 ? static_cast<Leaf*>(parent->children[index - 1]) : nullptr;
+        Leaf* right = index < parent->count ? static_cast<Leaf*>(parent->children[index + 1]) : nullptr;
+        int need = MIN_KEYS - leaf->count;
+
+        if (left && left->count - need >= MIN_KEYS) {
+            for (int i = leaf->count - 1; i >= 0; i--) {
+                leaf->keys[i + need] = std::move(leaf->keys[i]);
+                leaf->values[i + need] = std::move(leaf->values[i]);
+            }
+            for (int i = 0; i < need; i++) {
+                leaf->keys[i] = std::move(left->keys[left->count - need + i]);
+                leaf->values[i] = std::move(left->values[left->count - need + i]);
+            }
+            leaf->count += need;
+            left->count -= need;
+            parent->keys[index - 1] = leaf->keys[0];
+        } else if (right && right->count - need >= MIN_KEYS) {
+            for (int i = 0; i < need; i++) {
+                leaf->keys[leaf->count + i] = std::move(right->keys[i]);
+                leaf->values[leaf->count + i] = std::move(right->values[i]);
+            }
+            leaf->count += need;
+            for (int i = 0; i < right->count - need; i++) {
+                right->keys[i] = std::move(right->keys[i + need]);
+                right->values[i] = std::move(right->values[i + need]);
+            }
+            right->count -= need;
+            parent->keys[index] = right->keys[0];
+        } else if (left) {
+            mergeLeaf(left, leaf);
+            removeFromInner(parent, index - 1);
+        } else if (right) {
+            mergeLeaf(leaf, right);
+            removeFromInner(parent, index);
+        }
+    }
+
+    // Pindahkan isi `right` ke ujung `left`, lepas `right` dari rantai leaf.
+    void mergeLeaf(Leaf* left, Leaf* right) {
+        for (int i = 0; i < right->count; i++) {
+            left->keys[left->count + i] = std::move(right->keys[i]);
+            left->values[left->count + i] = std::move(right->values[i]);
+        }
+        left->count += right->count;
+        left->next = right->next;
+        leafPool_.destroy(right);
+    }
+
+    // Hapus separator keys[idx] beserta anak kanannya (children[idx + 1],
+    // yang sudah digabung ke kirinya) dari `cursor`, lalu perbaiki underflow
+    // node internal dengan pinjam/merge yang sama.
+    void removeFromInner(Inner* cursor, int idx) {
+        for (int i = idx; i < cursor->count - 1; i++) {
+            cursor->keys[i] = std::move(cursor->keys[i + 1]);
+        }
+        for (int i = idx + 1; i < cursor->count; i++) {
+            cursor->children[i] = cursor->children[i + 1];
+        }
+        cursor->count--;
+
+        if (cursor == root_) {
+            if (cursor->count == 0) {
+                root_ = cursor->children[0];
+                root_->parent = nullptr;
+                innerPool_.destroy(cursor);
+            }
+            return;
+        }
+
+        if (cursor->count >= MIN_KEYS) return;
+
+        Inner* parent = cursor->parent;
+        int index = childIndex(parent, cursor);
+
+        Inner* left = (index > 0) ? static_cast<Inner*>(parent->children[index - 1]) : nullptr;
+        Inner* right = (index < parent->count) ? static_cast<Inner*>(parent->children[index + 1]) : nullptr;
+
+        if (left && left->count > MIN_KEYS) {
+            for (int i = cursor->count; i > 0; i--) {
+                cursor->keys[i] = std::move(cursor->keys[i - 1]);
+            }
+            for (int i = cursor->count + 1; i > 0; i--) {
+                cursor->children[i] = cursor->children[i - 1];
+            }
+            cursor->keys[0] = std::move(parent->keys[index - 1]);
+            parent->keys[index - 1] = std::move(left->keys[left->count - 1]);
+            cursor->children[0] = left->children[left->count];
+            cursor->children[0]->parent = cursor;
+            cursor->count++;
+            left->count--;
+        } else if (right && right->count > MIN_KEYS) {
+            cursor->keys[cursor->count] = std::move(parent->keys[index]);
+            parent->keys[index] = std::move(right->keys[0]);
+            cursor->children[cursor->count + 1] = right->children[0];
+            cursor->children[cursor->count + 1]->parent = cursor;
+            cursor->count++;
+            for (int i = 0; i < right->count - 1; i++) {
+                right->keys[i] = std::move(right->keys[i + 1]);
+            }
+            for (int i = 0; i < right->count; i++) {
+                right->children[i] = right->children[i + 1];
+            }
+            right->count--;
+        } else if (left) {
+            mergeInternal(left, parent->keys[index - 1], cursor);
+            innerPool_.destroy(cursor);
+            removeFromInner(parent, index - 1);
+        } else if (right) {
+            mergeInternal(cursor, parent->keys[index], right);
+            innerPool_.destroy(right);
+            removeFromInner(parent, index);
+        }
+    }
+
+    // Gabungkan separator dan isi `right` ke ujung `left`.
+    void mergeInternal(Inner* left, const Key& separator, Inner* right) {
+        left->keys[left->count] = separator;
+        for (int i = 0; i < right->count; i++) {
+            left->keys[left->count + 1 + i] = std::move(right->keys[i]);
+        }
+        for (int i = 0; i <= right->count; i++) {
+            left->children[left->count + 1 + i] = right->children[i];
+            right->children[i]->parent = left;
+        }
+        left->count += right->count + 1;
+    }
+
+    void destroy(Node* node) {
+        if (!node) return;
+        if (node->isLeaf) {
+            leafPool_.destroy(static_cast<Leaf*>(node));
+            return;
+        }
+        Inner* inner = static_cast<Inner*>(node);
+        for (int i = 0; i <= inner->count; i++) destroy(inner->children[i]);
+        innerPool_.destroy(inner);
+    }
+};
+
+#endif
@@ -0,0 +1,313 @@
+#ifndef BPLUS_WAL_H
+#define BPLUS_WAL_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bplus_file.h"
+#include "bplus_tree.h"
+#include "hash_function.h"
+
+// B+ tree di memori dengan durability lewat write-ahead log.
+//
+//   <snapshot>  : file page biner (bplus_file.h) hasil checkpoint terakhir;
+//                 header-nya mencatat LSN record terakhir yang sudah masuk.
+//   <log>       : header 16 byte lalu record berukuran tetap
+//                 (lsn, op, checksum, key, key baru, value), append-only.
+//
+// insert/remove/update langsung mengubah tree lalu menambah record ke batch
+// di memori; commit() menulis seluruh batch dan melakukan satu fdatasync
+// (group commit). Batch otomatis di-commit begitu berisi groupSize record,
+// jadi paling banyak groupSize - 1 mutasi terakhir bisa hilang saat crash.
+// checkpoint() menulis snapshot baru (file sementara, fsync, rename) lalu
+// mengosongkan log; checkpoint otomatis begitu log melewati batas byte,
+// sehingga waktu recovery tetap terbatas.
+//
+// open() melakukan recovery: muat snapshot, lalu replay record log dengan
+// LSN lebih besar dari LSN snapshot. Record terakhir yang terpotong,
+// checksum-nya salah (crash di tengah write), atau LSN-nya tidak berurutan
+// dibuang dan log dipotong di record valid terakhir.
+template <typename Key, typename Value = BPlusEmpty, int Order = 64,
+          typename Compare = std::less<Key>>
+class DurableBPlusTree {
+    static_assert(std::is_trivially_copyable<Key>::value, "Key WAL harus trivially copyable");
+    static_assert(std::is_trivially_copyable<Value>::value, "Value WAL harus trivially copyable");
+
+    enum Op : uint32_t { OP_INSERT = 1, OP_REMOVE = 2, OP_UPDATE = 3 };
+
+    struct LogHeader {
+        char magic[8];
+        uint32_t keyBytes;
+        uint32_t valueBytes;
+    };
+
+    struct RecordHeader {
+        uint64_t lsn;
+        uint32_t op;
+        uint32_t checksum;
+    };
+
+    static constexpr char LOG_MAGIC[8] = {'B', 'P', 'W', 'A', 'L', '0', '0', '1'};
+    static constexpr size_t VALUE_BYTES = std::is_empty<Value>::value ? 0 : sizeof(Value);
+    static constexpr size_t KEY_OFFSET = sizeof(RecordHeader);
+    static constexpr size_t NEW_KEY_OFFSET = KEY_OFFSET + sizeof(Key);
+    static constexpr size_t VALUE_OFFSET = NEW_KEY_OFFSET + sizeof(Key);
+    static constexpr size_t RECORD_BYTES = VALUE_OFFSET + VALUE_BYTES;
+
+public:
+    typedef BPlusTree<Key, Value, Order, Compare> Tree;
+
+    DurableBPlusTree(std::string snapshotPath, std::string logPath, size_t groupSize = 64,
+                     size_t checkpointBytes = 64 << 20)
+        : snapshotPath_(std::move(snapshotPath)), logPath_(std::move(logPath)),
+          groupSize_(groupSize ? groupSize : 1), checkpointBytes_(checkpointBytes) {}
+
+    ~DurableBPlusTree() { close(); }
+
+    DurableBPlusTree(const DurableBPlusTree&) = delete;
+    DurableBPlusTree& operator=(const DurableBPlusTree&) = delete;
+
+    // Recovery: snapshot (kalau ada) lalu replay log. File yang belum ada
+    // dibuat kosong. Mengembalikan false (dan pesan di `error`) kalau file
+    // tidak bisa dibuka atau formatnya tidak cocok.
+    bool open(std::string* error = nullptr) {
+        close();
+        auto fail = [&](const std::string& msg) {
+            if (error) *error = msg;
+            close();
+            return false;
+        };
+        tree_.reset(new Tree());
+        ok_ = true;
+        replayed_ = discarded_ = 0;
+
+        uint64_t snapshotLsn = 0;
+        if (access(snapshotPath_.c_str(), F_OK) == 0) {
+            MappedBPlusFile<Key, Value> snapshot;
+            std::string why;
+            if (!snapshot.open(snapshotPath_.c_str(), &why)) return fail("snapshot: " + why);
+            std::vector<Key> keys;
+            std::vector<Value> values;
+            keys.reserve(snapshot.size());
+            values.reserve(snapshot.size());
+            snapshot.forEach([&](const Key& k, const Value& v) {
+                keys.push_back(k);
+                values.push_back(v);
+            });
+            if (!tree_->bulkLoad(keys.begin(), keys.end(), values.begin(), 1.0)) {
+                return fail("snapshot: key tidak terurut");
+            }
+            snapshotLsn = snapshot.walLsn();
+        }
+        lastLsn_ = snapshotLsn;
+
+        fd_ = ::open(logPath_.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) return fail("tidak dapat membuka log " + logPath_);
+        struct stat st;
+        if (fstat(fd_, &st) != 0) return fail("fstat log gagal");
+
+        if (st.st_size < (off_t)sizeof(LogHeader)) {
+            if (!resetLog()) return fail("tidak dapat menulis header log");
+        } else {
+            LogHeader header;
+            if (pread(fd_, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+                memcmp(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0) {
+                return fail("bukan file WAL B+ tree");
+            }
+            if (header.keyBytes != sizeof(Key) || header.valueBytes != VALUE_BYTES) {
+                return fail("ukuran key/value log tidak cocok");
+            }
+            if (!replay(st.st_size, snapshotLsn)) return fail("gagal membaca log");
+        }
+        return true;
+    }
+
+    // Tulis batch yang tersisa lalu tutup log. Tidak melakukan checkpoint.
+    void close() {
+        if (fd_ >= 0) {
+            commit();
+            ::close(fd_);
+        }
+        fd_ = -1;
+    }
+
+    bool insert(const Key& key, const Value& value = Value()) {
+        if (!tree_->insert(key, value)) return false;
+        append(OP_INSERT, key, key, value);
+        return true;
+    }
+
+    bool remove(const Key& key) {
+        if (!tree_->remove(key)) return false;
+        append(OP_REMOVE, key, key, Value());
+        return true;
+    }
+
+    bool update(const Key& oldKey, const Key& newKey) {
+        if (!tree_->update(oldKey, newKey)) return false;
+        append(OP_UPDATE, oldKey, newKey, Value());
+        return true;
+    }
+
+    // Tulis batch ke log dengan satu write dan satu fdatasync.
+    bool commit() {
+        if (batch_.empty()) return ok_;
+        if (fd_ < 0) return false;
+        const unsigned char* p = batch_.data();
+        size_t left = batch_.size();
+        while (left > 0 && ok_) {
+            ssize_t n = ::write(fd_, p, left);
+            if (n <= 0) {
+                ok_ = false;
+                break;
+            }
+            p += n;
+            left -= n;
+        }
+        ok_ = ok_ && fdatasync(fd_) == 0;
+        logBytes_ += batch_.size();
+        batch_.clear();
+        syncs_++;
+        if (ok_ && logBytes_ >= checkpointBytes_) return checkpoint();
+        return ok_;
+    }
+
+    // Snapshot tree ke file sementara (di-fsync), rename menimpa snapshot
+    // lama, baru log dikosongkan. Crash di antara rename dan pengosongan log
+    // aman: record dengan LSN <= LSN snapshot dilewati saat replay.
+    bool checkpoint() {
+        if (!batch_.empty() && !commit()) return false;
+        if (fd_ < 0) return false;
+        std::string tmp = snapshotPath_ + ".tmp";
+        if (!saveBPlusFile(*tree_, tmp.c_str(), lastLsn_, true)) return ok_ = false;
+        if (rename(tmp.c_str(), snapshotPath_.c_str()) != 0) return ok_ = false;
+        syncDirectory(snapshotPath_);
+        checkpoints_++;
+        return ok_ = resetLog();
+    }
+
+    const Tree& tree() const { return *tree_; }
+    bool search(const Key& key) const { return tree_->search(key); }
+    size_t size() const { return tree_->size(); }
+
+    // false setelah ada write/fsync yang gagal; mutasi berikutnya tidak
+    // lagi dijamin durable.
+    bool healthy() const { return ok_; }
+    uint64_t lastLsn() const { return lastLsn_; }
+    size_t pendingRecords() const { return batch_.size() / RECORD_BYTES; }
+    size_t logBytes() const { return logBytes_; }
+    size_t replayedRecords() const { return replayed_; }
+    size_t discardedBytes() const { return discarded_; }
+    size_t syncs() const { return syncs_; }
+    size_t checkpoints() const { return checkpoints_; }
+
+private:
+    std::unique_ptr<Tree> tree_{new Tree()};
+    std::string snapshotPath_;
+    std::string logPath_;
+    size_t groupSize_;
+    size_t checkpointBytes_;
+    int fd_ = -1;
+    bool ok_ = true;
+    uint64_t lastLsn_ = 0;
+    std::vector<unsigned char> batch_;
+    size_t logBytes_ = 0;  // byte record di log (tanpa header)
+    size_t replayed_ = 0;
+    size_t discarded_ = 0;
+    size_t syncs_ = 0;
+    size_t checkpoints_ = 0;
+
+    static uint32_t checksum(const unsigned char* record) {
+        RecordHeader header;
+        memcpy(&header, record, sizeof(header));
+        uint64_t h = hashBytes(record + KEY_OFFSET, RECORD_BYTES - KEY_OFFSET, header.lsn * 4 + header.op);
+        return (uint32_t)(h ^ (h >> 32));
+    }
+
+    void append(uint32_t op, const Key& key, const Key& newKey, const Value& value) {
+        size_t at = batch_.size();
+        batch_.resize(at + RECORD_BYTES, 0);
+        unsigned char* record = batch_.data() + at;
+        RecordHeader header = {++lastLsn_, op, 0};
+        memcpy(record + KEY_OFFSET, &key, sizeof(Key));
+        memcpy(record + NEW_KEY_OFFSET, &newKey, sizeof(Key));
+        if (VALUE_BYTES) memcpy(record + VALUE_OFFSET, &value, VALUE_BYTES);
+        memcpy(record, &header, sizeof(header));
+        header.checksum = checksum(record);
+        memcpy(record, &header, sizeof(header));
+        if (batch_.size() >= groupSize_ * RECORD_BYTES) commit();
+    }
+
+    // Baca log sekaligus, terapkan record valid, potong sisa yang rusak.
+    bool replay(size_t fileBytes, uint64_t snapshotLsn) {
+        std::vector<unsigned char> data(fileBytes - sizeof(LogHeader));
+        size_t got = 0;
+        while (got < data.size()) {
+            ssize_t n = pread(fd_, data.data() + got, data.size() - got, sizeof(LogHeader) + got);
+            if (n <= 0) return false;
+            got += n;
+        }
+
+        size_t pos = 0;
+        for (; pos + RECORD_BYTES <= data.size(); pos += RECORD_BYTES) {
+            const unsigned char* record = data.data() + pos;
+            RecordHeader header;
+            memcpy(&header, record, sizeof(header));
+            if (header.checksum != checksum(record)) break;
+            if (header.lsn <= snapshotLsn) continue;
+            if (header.lsn != lastLsn_ + 1) break;  // LSN harus berurutan
+
+            Key key, newKey;
+            Value value = Value();
+            memcpy(&key, record + KEY_OFFSET, sizeof(Key));
+            memcpy(&newKey, record + NEW_KEY_OFFSET, sizeof(Key));
+            if (VALUE_BYTES) memcpy(&value, record + VALUE_OFFSET, VALUE_BYTES);
+            switch (header.op) {
+                case OP_INSERT: tree_->insert(key, value); break;
+                case OP_REMOVE: tree_->remove(key); break;
+                case OP_UPDATE: tree_->update(key, newKey); break;
+                default: return false;
+            }
+            lastLsn_ = header.lsn;
+            replayed_++;
+        }
+
+        discarded_ = data.size() - pos;
+        logBytes_ = pos;
+        if (discarded_ > 0 && (ftruncate(fd_, sizeof(LogHeader) + pos) != 0 || fdatasync(fd_) != 0)) return false;
+        return lseek(fd_, 0, SEEK_END) >= 0;
+    }
+
+    bool resetLog() {
+        LogHeader header;
+        memcpy(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+        header.keyBytes = sizeof(Key);
+        header.valueBytes = VALUE_BYTES;
+        logBytes_ = 0;
+        return ftruncate(fd_, 0) == 0 && pwrite(fd_, &header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+               fdatasync(fd_) == 0 && lseek(fd_, 0, SEEK_END) >= 0;
+    }
+
+    // Supaya rename snapshot sendiri ikut durable.
+    static void syncDirectory(const std::string& path) {
+        size_t slash = path.find_last_of('/');
+        std::string dir = slash == std::string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+        int dfd = ::open(dir.c_str(), O_RDONLY);
+        if (dfd >= 0) {
+            fsync(dfd);
+            ::close(dfd);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef CUCKOO_FILTER_H
+#define CUCKOO_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "memory_stats.h"
+
+// Cuckoo filter (Fan et al.): filter keanggotaan perkiraan yang, berbeda
+// dengan Bloom filter, mendukung hapus. Dipasang di depan hash table / B+
+// tree supaya lookup key yang tidak ada ditolak tanpa menyentuh struktur.
+// Tidak pernah false negative selama yang dihapus hanya key yang pernah
+// ditambahkan dan setiap add yang gagal ditindaklanjuti dengan membangun
+// ulang filter (lihat add).
+//
+// Filter bekerja pada hash 64-bit dari pemanggil: 16 bit atas menjadi
+// fingerprint (0 berarti slot kosong), bit bawah index bucket. Satu bucket
+// = empat fingerprint 16-bit dalam satu uint64, jadi keempatnya dicocokkan
+// sekaligus dengan trik SWAR (SIMD di dalam satu register) tanpa loop, dan
+// satu lookup membaca paling banyak dua word. Bucket alternatif
+// i2 = i1 ^ h(fingerprint), sehingga fingerprint bisa dipindah tanpa key
+// aslinya. FPR kira-kira 8 x load / 65536 (~0.01% pada load 90%).
+class CuckooFilter {
+public:
+    static const int SLOTS = 4;
+
+    explicit CuckooFilter(size_t expectedKeys = 1024) { reset(expectedKeys); }
+
+    // Kosongkan dan ukur ulang supaya expectedKeys muat di load <= 90%.
+    void reset(size_t expectedKeys) {
+        size_t n = 1;
+        while (n * SLOTS * 9 / 10 < expectedKeys) n <<= 1;
+        buckets_.assign(n, 0);
+        mask_ = n - 1;
+        size_ = 0;
+        victim_ = 0;
+        kicks_ = 0;
+    }
+
+    // Kalau kedua bucket penuh dan rantai pengusiran tidak berujung,
+    // fingerprint terakhir yang tersisih disimpan di slot victim (tetap dicek
+    // oleh mayContain) dan full() menjadi true. Selama full(), add menolak
+    // key baru: hasil false berarti key TIDAK tercatat dan mayContain bisa
+    // menjawab false untuknya. Filter hanya menyimpan fingerprint, jadi tidak
+    // bisa tumbuh sendiri; pemanggil wajib reset() lebih besar lalu menambah
+    // ulang semua key dari strukturnya sebelum memakai mayContain lagi.
+    [[nodiscard]] bool add(uint64_t hash) {
+        if (victim_) return false;
+        uint16_t fp = fingerprint(hash);
+        size_t i1 = hash & mask_;
+        size_t i2 = altIndex(i1, fp);
+        if (place(i1, fp) || place(i2, fp)) {
+            size_++;
+            return true;
+        }
+
+        // Keduanya penuh: usir fingerprint acak ke bucket alternatifnya.
+        size_t i = (kicks_ & 1) ? i1 : i2;
+        for (int n = 0; n < MAX_KICKS; n++) {
+            kicks_ = kicks_ * 6364136223846793005ULL + 1442695040888963407ULL;
+            int lane = (kicks_ >> 62) & (SLOTS - 1);
+            uint16_t evicted = getLane(buckets_[i], lane);
+            setLane(buckets_[i], lane, fp);
+            fp = evicted;
+            i = altIndex(i, fp);
+            if (place(i, fp)) {
+                size_++;
+                return true;
+            }
+        }
+        victim_ = fp;
+        victimIndex_ = i;
+        size_++;
+        return true;
+    }
+
+    bool mayContain(uint64_t hash) const {
+        uint16_t fp = fingerprint(hash);
+        size_t i1 = hash & mask_;
+        size_t i2 = altIndex(i1, fp);
+        bool hit = hasLane(buckets_[i1], fp) | hasLane(buckets_[i2], fp);
+        return hit || (victim_ == fp && (victimIndex_ == i1 || victimIndex_ == i2));
+    }
+
+    // Hapus satu salinan fingerprint; hanya untuk key yang memang ada.
+    bool remove(uint64_t hash) {
+        uint16_t fp = fingerprint(hash);
+        size_t i1 = hash & mask_;
+        size_t i2 = altIndex(i1, fp);
+        if (clear(i1, fp) || clear(i2, fp)) {
+            size_--;
+            if (victim_) reinsertVictim();
+            return true;
+        }
+        if (victim_ == fp && (victimIndex_ == i1 || victimIndex_ == i2)) {
+            victim_ = 0;
+            size_--;
+            return true;
+        }
+        return false;
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return buckets_.size() * SLOTS; }
+    double loadFactor() const { return (double)size_ / capacity(); }
+    bool full() const { return victim_ != 0; }
+    size_t bytes() const { return heapBlockBytes(buckets_.data()); }
+
+private:
+    static const int MAX_KICKS = 500;
+    static constexpr uint64_t LANES = 0x0001000100010001ULL;
+    static constexpr uint64_t HIGH_BITS = 0x8000800080008000ULL;
+
+    std::vector<uint64_t> buckets_;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+    uint16_t victim_ = 0;
+    size_t victimIndex_ = 0;
+    uint64_t kicks_ = 0;
+
+    static uint16_t fingerprint(uint64_t hash) {
+        uint16_t fp = hash >> 48;
+        return fp ? fp : 1;
+    }
+
+    size_t altIndex(size_t i, uint16_t fp) const { return (i ^ (fp * 0x5bd1e995ULL)) & mask_; }
+
+    // Bit tinggi lane yang sama dengan fp. Hasil tidak nol tepat ketika ada
+    // lane yang cocok, dan bit terendahnya selalu menunjuk lane yang benar.
+    static uint64_t matchLanes(uint64_t word, uint16_t fp) {
+        uint64_t x = word ^ (fp * LANES);
+        return (x - LANES) & ~x & HIGH_BITS;
+    }
+
+    static bool hasLane(uint64_t word, uint16_t fp) { return matchLanes(word, fp) != 0; }
+    static uint16_t getLane(uint64_t word, int lane) { return word >> (16 * lane); }
+    static void setLane(uint64_t& word, int lane, uint16_t fp) {
+        word = (word & ~(0xffffULL << (16 * lane))) | ((uint64_t)fp << (16 * lane));
+    }
+
+    bool place(size_t i, uint16_t fp) {
+        uint64_t empty = matchLanes(buckets_[i], 0);
+        if (!empty) return false;
+        setLane(buckets_[i], __builtin_ctzll(empty) / 16, fp);
+        return true;
+    }
+
+    bool clear(size_t i, uint16_t fp) {
+        uint64_t match = matchLanes(buckets_[i], fp);
+        if (!match) return false;
+        setLane(buckets_[i], __builtin_ctzll(match) / 16, 0);
+        return true;
+    }
+
+    // Setelah hapus ada slot kosong lagi; coba kembalikan victim ke tabel.
+    void reinsertVictim() {
+        uint16_t fp = victim_;
+        size_t i = victimIndex_;
+        if (place(i, fp) || place(altIndex(i, fp), fp)) victim_ = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef DATA_LOADER_H
+#define DATA_LOADER_H
+
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// File data yang di-mmap utuh. Parser di bawah berjalan langsung di atas
+// isi mapping: int diparse dengan from_chars dan baris string dikembalikan
+// sebagai string_view, jadi tidak ada buffer per baris maupun alokasi.
+class DataFile {
+public:
+    DataFile() = default;
+    ~DataFile() { close(); }
+
+    DataFile(const DataFile&) = delete;
+    DataFile& operator=(const DataFile&) = delete;
+
+    bool open(const char* path) {
+        close();
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size_ = st.st_size;
+        if (size_ > 0) {
+            void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                ::close(fd);
+                size_ = 0;
+                return false;
+            }
+            madvise(data, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(data);
+        }
+        ::close(fd);
+        return true;
+    }
+
+    void close() {
+        if (data_) munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    std::string_view text() const { return std::string_view(data_ ? data_ : "", size_); }
+    size_t bytes() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+// Panggil fn(int) untuk setiap token angka. Token lain (misal header
+// "integer" di bplus.db) dilewati. Mengembalikan jumlah angka.
+template <typename Fn>
+size_t parseInts(std::string_view text, Fn&& fn) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    size_t count = 0;
+    while (p < end) {
+        while (p < end && isSpace(*p)) p++;
+        if (p == end) break;
+        int value;
+        auto result = std::from_chars(p, end, value);
+        if (result.ec == std::errc() && (result.ptr == end || isSpace(*result.ptr))) {
+            fn(value);
+            count++;
+            p = result.ptr;
+        } else {
+            while (p < end && !isSpace(*p)) p++;
+        }
+    }
+    return count;
+}
+
+// Panggil fn(string_view) untuk setiap baris yang tidak kosong, tanpa
+// spasi/'\r' di ujungnya. Mengembalikan jumlah baris.
+template <typename Fn>
+size_t parseLines(std::string_view text, Fn&& fn) {
+    size_t count = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string_view::npos) eol = text.size();
+        size_t first = pos, last = eol;
+        while (first < last && isSpace(text[first])) first++;
+        while (last > first && isSpace(text[last - 1])) last--;
+        if (last > first) {
+            fn(text.substr(first, last - first));
+            count++;
+        }
+        pos = eol + 1;
+    }
+    return count;
+}
+
+// Panggil fn(string_view) untuk setiap token yang dipisah whitespace, sama
+// dengan loop fscanf("%s") (tanpa batas panjang token). Mengembalikan
+// jumlah token.
+template <typename Fn>
+size_t parseWords(std::string_view text, Fn&& fn) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    size_t count = 0;
+    while (p < end) {
+        while (p < end && isSpace(*p)) p++;
+        if (p == end) break;
+        const char* start = p;
+        while (p < end && !isSpace(*p)) p++;
+        fn(std::string_view(start, p - start));
+        count++;
+    }
+    return count;
+}
+
+// Throughput load: dipakai semua program supaya ingest bisa dibandingkan.
+inline void printLoadStats(const char* path, size_t bytes, size_t items,
+                           std::chrono::steady_clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    double mb = bytes / (1024.0 * 1024.0);
+    std::cout << "Load " << path << ": " << items << " item, " << bytes << " byte dalam "
+              << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() << " us";
+    if (seconds > 0) std::cout << " (" << mb / seconds << " MB/s)";
+    std::cout << "\n";
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// Epoch-based reclamation. Pembaca membungkus akses ke struktur bersama
+// dengan EpochManager::Guard; objek yang sudah dilepas dari struktur
+// diserahkan ke retire() dan baru dihapus setelah semua thread yang mungkin
+// masih memegangnya keluar dari guard (dua epoch kemudian).
+namespace epoch_detail {
+
+const int MAX_THREADS = 256;
+
+// Id kecil per thread, dipakai ulang setelah thread selesai.
+struct ThreadSlot {
+    int id;
+
+    ThreadSlot() {
+        std::lock_guard<std::mutex> guard(mutex());
+        if (!freeIds().empty()) {
+            id = freeIds().back();
+            freeIds().pop_back();
+        } else {
+            id = nextId().fetch_add(1, std::memory_order_relaxed);
+        }
+        if (id >= MAX_THREADS) throw std::runtime_error("epoch: terlalu banyak thread");
+    }
+
+    ~ThreadSlot() {
+        std::lock_guard<std::mutex> guard(mutex());
+        freeIds().push_back(id);
+    }
+
+    static std::mutex& mutex() {
+        static std::mutex m;
+        return m;
+    }
+    static std::vector<int>& freeIds() {
+        static std::vector<int> ids;
+        return ids;
+    }
+    // Batas atas id yang pernah dibagikan; slot di atasnya tidak perlu dipindai.
+    static std::atomic<int>& nextId() {
+        static std::atomic<int> next{0};
+        return next;
+    }
+};
+
+inline int threadId() {
+    thread_local ThreadSlot slot;
+    return slot.id;
+}
+
+}  // namespace epoch_detail
+
+class EpochManager {
+    static const uint64_t IDLE = UINT64_MAX;
+    static const size_t COLLECT_BATCH = 256;  // retire per percobaan collect
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch;
+    };
+
+public:
+    EpochManager() {
+        for (Slot& s : slots_) s.epoch.store(IDLE, std::memory_order_relaxed);
+    }
+
+    ~EpochManager() {
+        for (Retired& r : limbo_) r.free();
+    }
+
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    // Selama Guard hidup, objek yang terlihat dari struktur tidak akan
+    // dihapus. Tidak boleh bersarang di thread yang sama.
+    class Guard {
+    public:
+        explicit Guard(EpochManager& mgr) : slot_(mgr.slots_[epoch_detail::threadId()]) {
+            slot_.epoch.store(mgr.epoch_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        ~Guard() { slot_.epoch.store(IDLE, std::memory_order_release); }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        Slot& slot_;
+    };
+
+    template <typename T>
+    void retire(T* ptr) {
+        retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+    }
+
+    void retire(void* ptr, void (*deleter)(void*)) {
+        std::lock_guard<std::mutex> guard(limboMutex_);
+        limbo_.push_back({ptr, deleter, epoch_.load(std::memory_order_relaxed)});
+        if (limbo_.size() >= nextCollect_) collect();
+    }
+
+    size_t pending() const {
+        std::lock_guard<std::mutex> guard(limboMutex_);
+        return limbo_.size();
+    }
+
+private:
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+        uint64_t epoch;
+
+        void free() { deleter(ptr); }
+    };
+
+    std::atomic<uint64_t> epoch_{0};
+    Slot slots_[epoch_detail::MAX_THREADS];
+    mutable std::mutex limboMutex_;
+    std::vector<Retired> limbo_;
+    size_t nextCollect_ = COLLECT_BATCH;
+
+    // Naikkan epoch kalau semua thread aktif sudah melihat epoch sekarang,
+    // lalu hapus objek yang di-retire paling tidak dua epoch sebelumnya.
+    // Dipanggil dengan limboMutex_ terkunci.
+    void collect() {
+        uint64_t current = epoch_.load(std::memory_order_seq_cst);
+        bool advance = true;
+        int threads = std::min(epoch_detail::ThreadSlot::nextId().load(std::memory_order_acquire),
+                               epoch_detail::MAX_THREADS);
+        for (int i = 0; i < threads; i++) {
+            uint64_t e = slots_[i].epoch.load(std::memory_order_seq_cst);
+            if (e != IDLE && e != current) {
+                advance = false;
+                break;
+            }
+        }
+        if (advance) epoch_.store(++current, std::memory_order_seq_cst);
+
+        size_t kept = 0;
+        for (Retired& r : limbo_) {
+            if (r.epoch + 2 <= current) {
+                r.free();
+            } else {
+                limbo_[kept++] = r;
+            }
+        }
+        limbo_.resize(kept);
+        nextCollect_ = kept + COLLECT_BATCH;
+    }
+};
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef HASH_FUNCTION_H
+#define HASH_FUNCTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+
+// Finalizer splitmix64: menyebarkan bit key supaya key berurutan
+// tidak menumpuk di slot yang berdekatan.
+inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+namespace hash_detail {
+
+const uint64_t SECRET[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+                            0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+
+// Perkalian 64x64 -> 128 bit; a = 64 bit bawah, b = 64 bit atas.
+inline void mul128(uint64_t& a, uint64_t& b) {
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    a = static_cast<uint64_t>(r);
+    b = static_cast<uint64_t>(r >> 64);
+}
+
+// Perkalian 128 bit yang dilipat jadi 64 bit.
+inline uint64_t mum(uint64_t a, uint64_t b) {
+    mul128(a, b);
+    return a ^ b;
+}
+
+inline uint64_t read8(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t read4(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+}  // namespace hash_detail
+
+// Hash seluruh byte key (gaya wyhash): setiap byte ikut menentukan hasil,
+// dan seed yang berbeda menghasilkan fungsi hash yang berbeda.
+inline uint64_t hashBytes(const void* data, size_t len, uint64_t seed = 0) {
+    using namespace hash_detail;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    seed ^= mum(seed ^ SECRET[0], SECRET[1]);
+    uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+            b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = (uint64_t(p[0]) << 16) | (uint64_t(p[len >> 1]) << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = mum(read8(p) ^ SECRET[1], read8(p + 8) ^ seed);
+                see1 = mum(read8(p + 16) ^ SECRET[2], read8(p + 24) ^ see1);
+                see2 = mum(read8(p + 32) ^ SECRET[3], read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = mum(read8(p) ^ SECRET[1], read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+    }
+    a ^= SECRET[1];
+    b ^= seed;
+    mul128(a, b);
+    return mum(a ^ SECRET[0] ^ len, b ^ SECRET[1]);
+}
+
+inline uint64_t hashString(const std::string& key, uint64_t seed = 0) {
+    return hashBytes(key.data(), key.size(), seed);
+}
+
+// Hash 64-bit default untuk tabel open addressing.
+template <typename Key>
+struct KeyHash {
+    uint64_t operator()(const Key& key) const {
+        return mix64(std::hash<Key>{}(key));
+    }
+};
+
+template <>
+struct KeyHash<std::string> {
+    uint64_t seed = 0;
+
+    uint64_t operator()(const std::string& key) const {
+        return hashString(key, seed);
+    }
+};
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef HASHTABLE_ARENA_H
+#define HASHTABLE_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "hash_function.h"
+#include "memory_stats.h"
+
+// Hash table string tanpa node per key. Semua isi key ditulis berurutan ke
+// satu arena char (append-only); tabel adalah satu array datar entri (hash,
+// offset, panjang) ke arena dengan Robin Hood probing seperti
+// OpenHashTable. Insert tidak mengalokasi apa pun selain saat arena atau
+// tabel tumbuh, dan pencarian membandingkan hash di slot yang berurutan dulu
+// sebelum menyentuh arena.
+//
+// Byte key yang dihapus atau diganti menjadi "mati" di arena; begitu lebih
+// dari separuh arena mati, compact() menyalin key hidup ke arena baru.
+// Semantik `iterations` sama dengan OpenHashTable: jumlah slot yang
+// diperiksa.
+class StringArenaTable {
+public:
+    explicit StringArenaTable(size_t initialCapacity = 1024, double maxLoadFactor = 0.75, uint64_t seed = 0)
+        : maxLoadFactor_(maxLoadFactor), seed_(seed) {
+        size_t n = 8;
+        while (n < initialCapacity) n <<= 1;
+        allocate(n);
+    }
+
+    bool insert(std::string_view key) {
+        uint64_t hash = hashOf(key);
+        int iterations = 0;
+        if (find(hash, key, iterations) != NOT_FOUND) return false;
+        if (size_ + 1 > slots_.size() * maxLoadFactor_) rehash(slots_.size() * 2);
+        place(Entry{hash, append(key), (uint32_t)key.size()});
+        size_++;
+        return true;
+    }
+
+    bool search(std::string_view key, int& iterations) const {
+        iterations = 0;
+        return find(hashOf(key), key, iterations) != NOT_FOUND;
+    }
+
+    bool remove(std::string_view key, int& iterations) {
+        iterations = 0;
+        size_t idx = find(hashOf(key), key, iterations);
+        if (idx == NOT_FOUND) return false;
+        deadBytes_ += slots_[idx].length;
+        eraseSlot(idx);
+        size_--;
+        maybeCompact();
+        return true;
+    }
+
+    // Key baru yang tidak lebih panjang ditulis di atas byte key lama;
+    // selain itu ditambahkan di ujung arena. Entri dipindah ke slot baru
+    // tanpa alokasi per key. newKey boleh menunjuk ke dalam arena (misalnya
+    // hasil forEach).
+    bool update(std::string_view oldKey, std::string_view newKey, int& iterations) {
+        iterations = 0;
+        int search_iters = 0;
+        if (search(newKey, search_iters)) return false;
+
+        size_t idx = find(hashOf(oldKey), oldKey, iterations);
+        if (idx == NOT_FOUND) return false;
+        iterations += search_iters;
+
+        Entry e = slots_[idx];
+        eraseSlot(idx);
+        if (newKey.size() <= e.length) {
+            memmove(&arena_[e.offset], newKey.data(), newKey.size());
+            deadBytes_ += e.length - newKey.size();
+        } else {
+            deadBytes_ += e.length;
+            e.offset = append(newKey);
+        }
+        e.length = (uint32_t)newKey.size();
+        e.hash = hashOf(keyOf(e));
+        place(e);
+        maybeCompact();
+        return true;
+    }
+
+    // Salin key hidup ke arena baru yang pas ukurannya dan perbarui offset.
+    void compact() {
+        std::vector<char> fresh;
+        fresh.reserve(arena_.size() - deadBytes_);
+        for (Entry& e : slots_) {
+            if (e.offset == EMPTY) continue;
+            uint32_t offset = (uint32_t)fresh.size();
+            fresh.insert(fresh.end(), arena_.begin() + e.offset, arena_.begin() + e.offset + e.length);
+            e.offset = offset;
+        }
+        arena_.swap(fresh);
+        deadBytes_ = 0;
+        compactions_++;
+    }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Entry& e : slots_) {
+            if (e.offset != EMPTY) fn(keyOf(e));
+        }
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return slots_.size(); }
+    size_t arenaBytes() const { return arena_.size(); }
+    size_t deadBytes() const { return deadBytes_; }
+    size_t compactions() const { return compactions_; }
+
+    // Tidak ada node maupun pointer: slot kosong masuk slack, isi key di
+    // arena dihitung sebagai key di heap, dan capacity arena yang belum
+    // terpakai serta byte mati juga masuk slack.
+    MemoryStats memoryStats() const {
+        MemoryStats m;
+        m.keys = size_;
+        m.buckets = slots_.size();
+        m.keySlots = slots_.size();
+        m.totalBytes = heapBlockBytes(slots_.data());
+        m.slackBytes = m.totalBytes - size_ * sizeof(Entry);
+        size_t arenaBlock = heapBlockBytes(arena_.data());
+        m.totalBytes += arenaBlock;
+        m.keyHeapBytes = arena_.size() - deadBytes_;
+        m.slackBytes += arenaBlock - m.keyHeapBytes;
+        return m;
+    }
+
+private:
+    struct Entry {
+        uint64_t hash;
+        uint32_t offset;  // EMPTY untuk slot kosong
+        uint32_t length;
+    };
+
+    static const size_t NOT_FOUND = SIZE_MAX;
+    static const uint32_t EMPTY = UINT32_MAX;
+    static const size_t MIN_COMPACT_BYTES = 4096;
+
+    std::vector<Entry> slots_;
+    std::vector<char> arena_;
+    size_t mask_ = 0;
+    int shift_ = 0;
+    size_t size_ = 0;
+    size_t deadBytes_ = 0;
+    size_t compactions_ = 0;
+    double maxLoadFactor_;
+    uint64_t seed_;
+
+    uint64_t hashOf(std::string_view key) const { return hashBytes(key.data(), key.size(), seed_); }
+
+    std::string_view keyOf(const Entry& e) const { return std::string_view(arena_.data() + e.offset, e.length); }
+
+    // Bit atas hash dipakai sebagai index awal, seperti OpenHashTable. Jarak
+    // dari index awal dihitung ulang dari hash, jadi entri tetap 16 byte.
+    size_t homeIndex(uint64_t hash) const { return (size_t)(hash >> shift_) & mask_; }
+    size_t distance(size_t idx, const Entry& e) const { return (idx - homeIndex(e.hash)) & mask_; }
+
+    size_t find(uint64_t hash, std::string_view key, int& iterations) const {
+        size_t idx = homeIndex(hash);
+        for (size_t dist = 0;; dist++) {
+            iterations++;
+            const Entry& e = slots_[idx];
+            if (e.offset == EMPTY || distance(idx, e) < dist) return NOT_FOUND;
+            if (e.hash == hash && e.length == key.size() &&
+                memcmp(arena_.data() + e.offset, key.data(), key.size()) == 0) {
+                return idx;
+            }
+            idx = (idx + 1) & mask_;
+        }
+    }
+
+    // Sisipkan entri yang pasti belum ada; entri yang lebih dekat ke index
+    // awalnya digeser maju (Robin Hood).
+    void place(Entry e) {
+        size_t idx = homeIndex(e.hash);
+        for (size_t dist = 0;; dist++) {
+            Entry& s = slots_[idx];
+            if (s.offset == EMPTY) {
+                s = e;
+                return;
+            }
+            size_t d = distance(idx, s);
+            if (d < dist) {
+                std::swap(s, e);
+                dist = d;
+            }
+            idx = (idx + 1) & mask_;
+        }
+    }
+
+    // Backward shift deletion: geser entri berikutnya mundur satu slot,
+    // jadi tidak perlu tombstone.
+    void eraseSlot(size_t idx) {
+        size_t next = (idx + 1) & mask_;
+        while (slots_[next].offset != EMPTY && distance(next, slots_[next]) > 0) {
+            slots_[idx] = slots_[next];
+            idx = next;
+            next = (next + 1) & mask_;
+        }
+        slots_[idx].offset = EMPTY;
+    }
+
+    // key boleh menunjuk ke dalam arena_: kalau arena harus tumbuh, buffer
+    // lama tetap hidup sampai byte key selesai disalin.
+    uint32_t append(std::string_view key) {
+        if (arena_.size() + key.size() >= EMPTY) throw std::length_error("arena string penuh (4 GB)");
+        uint32_t offset = (uint32_t)arena_.size();
+        std::vector<char> old;
+        if (arena_.size() + key.size() > arena_.capacity()) {
+            old.reserve(std::max(arena_.capacity() * 2, arena_.size() + key.size()));
+            old.assign(arena_.begin(), arena_.end());
+            old.swap(arena_);
+        }
+        arena_.resize(offset + key.size());
+        if (!key.empty()) memcpy(arena_.data() + offset, key.data(), key.size());
+        return offset;
+    }
+
+    void maybeCompact() {
+        if (deadBytes_ >= MIN_COMPACT_BYTES && deadBytes_ * 2 > arena_.size()) compact();
+    }
+
+    void allocate(size_t n) {
+        slots_.assign(n, Entry{0, EMPTY, 0});
+        mask_ = n - 1;
+        int bits = 0;
+        while ((size_t(1) << bits) < n) bits++;
+        shift_ = 64 - bits;
+    }
+
+    // Entri membawa hash-nya sendiri, jadi rehash tidak membaca arena.
+    void rehash(size_t n) {
+        std::vector<Entry> old;
+        old.swap(slots_);
+        allocate(n);
+        for (const Entry& e : old) {
+            if (e.offset != EMPTY) place(e);
+        }
+    }
+};
+
+#endif
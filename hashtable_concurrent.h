@@ -0,0 +1,172 @@
+#ifndef HASHTABLE_CONCURRENT_H
+#define HASHTABLE_CONCURRENT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "epoch.h"
+#include "hash_function.h"
+
+// Hash table chaining yang aman dipakai banyak thread. Pencarian tidak
+// mengambil kunci: kepala bucket dan pointer next adalah atomic, dan node
+// yang dihapus baru dibebaskan lewat EpochManager setelah tidak ada pembaca
+// yang mungkin masih berada di dalamnya. Penulis mengunci satu stripe.
+//
+// Index bucket memakai bit atas hash (seperti OpenHashTable), jadi stripe =
+// STRIPE_BITS bit teratas hash selalu mencakup rentang bucket yang sama
+// berapa pun ukuran tabel. Resize mengunci semua stripe (penulis menunggu),
+// menyalin node ke tabel baru, lalu memasangnya dengan satu store atomic;
+// pembaca tetap berjalan di tabel lama sampai selesai.
+template <typename Key, typename Hash = KeyHash<Key>>
+class ConcurrentHashTable {
+    static const int STRIPE_BITS = 6;
+    static const size_t STRIPES = size_t(1) << STRIPE_BITS;
+
+    struct Node {
+        Key key;
+        uint64_t hash;
+        std::atomic<Node*> next;
+
+        Node(const Key& k, uint64_t h, Node* n) : key(k), hash(h), next(n) {}
+    };
+
+    struct Table {
+        size_t size;
+        int shift;
+        std::unique_ptr<std::atomic<Node*>[]> buckets;
+
+        explicit Table(size_t n) : size(n), shift(64), buckets(new std::atomic<Node*>[n]) {
+            for (size_t b = n; b > 1; b >>= 1) shift--;
+            for (size_t i = 0; i < n; i++) buckets[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        std::atomic<Node*>& bucket(uint64_t hash) { return buckets[hash >> shift]; }
+    };
+
+    struct alignas(64) Stripe {
+        std::mutex mutex;
+    };
+
+public:
+    explicit ConcurrentHashTable(size_t initialBuckets = 1024, double maxLoadFactor = 1.0)
+        : maxLoadFactor_(maxLoadFactor) {
+        size_t n = STRIPES;
+        while (n < initialBuckets) n <<= 1;
+        table_.store(new Table(n));
+    }
+
+    ~ConcurrentHashTable() { destroyTable(table_.load()); }
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    bool search(const Key& key) const {
+        uint64_t hash = hash_(key);
+        EpochManager::Guard guard(epochs_);
+        Table* table = table_.load(std::memory_order_acquire);
+        for (Node* curr = table->bucket(hash).load(std::memory_order_acquire); curr;
+             curr = curr->next.load(std::memory_order_acquire)) {
+            if (curr->hash == hash && curr->key == key) return true;
+        }
+        return false;
+    }
+
+    bool insert(const Key& key) {
+        uint64_t hash = hash_(key);
+        {
+            std::lock_guard<std::mutex> lock(stripeFor(hash).mutex);
+            std::atomic<Node*>& head = table_.load(std::memory_order_relaxed)->bucket(hash);
+            Node* first = head.load(std::memory_order_relaxed);
+            for (Node* curr = first; curr; curr = curr->next.load(std::memory_order_relaxed)) {
+                if (curr->hash == hash && curr->key == key) return false;
+            }
+            head.store(new Node(key, hash, first), std::memory_order_release);
+        }
+        size_t n = size_.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (n > capacity() * maxLoadFactor_) grow();
+        return true;
+    }
+
+    bool remove(const Key& key) {
+        uint64_t hash = hash_(key);
+        std::lock_guard<std::mutex> lock(stripeFor(hash).mutex);
+        std::atomic<Node*>* link = &table_.load(std::memory_order_relaxed)->bucket(hash);
+        for (Node* curr = link->load(std::memory_order_relaxed); curr;
+             curr = curr->next.load(std::memory_order_relaxed)) {
+            if (curr->hash == hash && curr->key == key) {
+                // curr->next tidak diubah, jadi pembaca yang sedang berada di
+                // curr tetap bisa melanjutkan ke sisa chain.
+                link->store(curr->next.load(std::memory_order_relaxed), std::memory_order_release);
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                epochs_.retire(curr);
+                return true;
+            }
+            link = &curr->next;
+        }
+        return false;
+    }
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+    size_t capacity() const { return table_.load(std::memory_order_acquire)->size; }
+    double loadFactor() const { return (double)size() / capacity(); }
+    size_t resizes() const { return resizes_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<Table*> table_;
+    std::atomic<size_t> size_{0};
+    std::atomic<size_t> resizes_{0};
+    double maxLoadFactor_;
+    Hash hash_;
+    Stripe stripes_[STRIPES];
+    std::mutex resizeMutex_;
+    mutable EpochManager epochs_;
+
+    static void destroyTable(void* ptr) {
+        Table* table = static_cast<Table*>(ptr);
+        for (size_t i = 0; i < table->size; i++) {
+            Node* curr = table->buckets[i].load(std::memory_order_relaxed);
+            while (curr) {
+                Node* next = curr->next.load(std::memory_order_relaxed);
+                delete curr;
+                curr = next;
+            }
+        }
+        delete table;
+    }
+
+    Stripe& stripeFor(uint64_t hash) { return stripes_[hash >> (64 - STRIPE_BITS)]; }
+
+    // Gandakan jumlah bucket. Hanya satu thread yang melakukannya; thread
+    // lain yang juga melewati batas load factor langsung kembali.
+    void grow() {
+        std::unique_lock<std::mutex> resizing(resizeMutex_, std::try_to_lock);
+        if (!resizing.owns_lock()) return;
+        for (Stripe& s : stripes_) s.mutex.lock();
+
+        Table* old = table_.load(std::memory_order_relaxed);
+        if (size() > old->size * maxLoadFactor_) {
+            // Node lama tidak dipindah (pembaca mungkin sedang menelusurinya),
+            // tapi disalin ke tabel baru. Chain lama tidak pernah diubah lagi,
+            // jadi tabel lama di-retire sekaligus dengan semua node-nya.
+            Table* bigger = new Table(old->size * 2);
+            for (size_t i = 0; i < old->size; i++) {
+                for (Node* curr = old->buckets[i].load(std::memory_order_relaxed); curr;
+                     curr = curr->next.load(std::memory_order_relaxed)) {
+                    std::atomic<Node*>& head = bigger->bucket(curr->hash);
+                    head.store(new Node(curr->key, curr->hash, head.load(std::memory_order_relaxed)),
+                               std::memory_order_relaxed);
+                }
+            }
+            table_.store(bigger, std::memory_order_release);
+            resizes_.fetch_add(1, std::memory_order_relaxed);
+            epochs_.retire(old, destroyTable);
+        }
+
+        for (Stripe& s : stripes_) s.mutex.unlock();
+    }
+};
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef HASHTABLE_INCREMENTAL_H
+#define HASHTABLE_INCREMENTAL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "hash_function.h"
+#include "memory_stats.h"
+
+// Hash table chaining yang tumbuh tanpa rehash stop-the-world. Begitu load
+// factor terlampaui, array bucket baru (2x) dibuat di samping yang lama;
+// setiap insert/search/remove lalu memindahkan paling banyak migrateStep
+// bucket lama ke array baru (node dipindah, tidak dialokasi ulang). Selama
+// migrasi, pencarian memeriksa bucket lama kalau belum dipindah, selain itu
+// bucket baru. Dengan migrateStep = 0 seluruh tabel dipindah sekaligus
+// (rehash biasa), sebagai pembanding.
+//
+// Index bucket memakai bit atas hash, jadi bucket lama i terbagi tepat ke
+// bucket baru 2i dan 2i + 1. Array baru juga tidak di-memset saat resize:
+// bucket 2i dan 2i + 1 baru dinolkan ketika bucket lama i dipindah, jadi
+// insert yang memicu resize hanya membayar satu alokasi. Semantik
+// `iterations` sama dengan versi chaining: jumlah node yang diperiksa.
+template <typename Key, typename Hash = KeyHash<Key>>
+class IncrementalHashTable {
+    struct Node {
+        Key key;
+        uint64_t hash;
+        Node* next;
+    };
+
+    struct Table {
+        std::unique_ptr<Node*[]> buckets;
+        size_t size = 0;
+        int shift = 64;
+
+        void allocate(size_t n, bool zero) {
+            buckets.reset(zero ? new Node*[n]() : new Node*[n]);
+            size = n;
+            shift = 64;
+            for (size_t b = n; b > 1; b >>= 1) shift--;
+        }
+
+        size_t index(uint64_t hash) const { return hash >> shift; }
+    };
+
+public:
+    explicit IncrementalHashTable(size_t initialBuckets = 16, double maxLoadFactor = 1.0, size_t migrateStep = 8)
+        : maxLoadFactor_(maxLoadFactor), migrateStep_(migrateStep) {
+        size_t n = 2;
+        while (n < initialBuckets) n <<= 1;
+        table_.allocate(n, true);
+    }
+
+    ~IncrementalHashTable() {
+        if (migrating()) freeChains(old_, migrated_, old_.size);
+        freeChains(table_, 0, readyBuckets());
+    }
+
+    IncrementalHashTable(const IncrementalHashTable&) = delete;
+    IncrementalHashTable& operator=(const IncrementalHashTable&) = delete;
+
+    bool insert(const Key& key) {
+        step();
+        uint64_t hash = hash_(key);
+        Node** head = bucketFor(hash);
+        for (Node* curr = *head; curr; curr = curr->next) {
+            if (curr->hash == hash && curr->key == key) return false;
+        }
+        *head = new Node{key, hash, *head};
+        size_++;
+        if (size_ > table_.size * maxLoadFactor_) startResize();
+        return true;
+    }
+
+    bool search(const Key& key, int& iterations) {
+        step();
+        iterations = 0;
+        uint64_t hash = hash_(key);
+        for (Node* curr = *bucketFor(hash); curr; curr = curr->next) {
+            iterations++;
+            if (curr->hash == hash && curr->key == key) return true;
+        }
+        return false;
+    }
+
+    bool remove(const Key& key, int& iterations) {
+        step();
+        iterations = 0;
+        uint64_t hash = hash_(key);
+        for (Node** link = bucketFor(hash); *link; link = &(*link)->next) {
+            iterations++;
+            Node* curr = *link;
+            if (curr->hash == hash && curr->key == key) {
+                *link = curr->next;
+                delete curr;
+                size_--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t size() const { return size_; }
+    size_t bucketCount() const { return table_.size; }
+    double loadFactor() const { return (double)size_ / table_.size; }
+    bool migrating() const { return old_.buckets != nullptr; }
+    size_t resizes() const { return resizes_; }
+
+    MemoryStats memoryStats() const {
+        MemoryStats m;
+        auto add = [&](const Table& t, size_t from, size_t to) {
+            m.buckets += t.size;
+            m.totalBytes += heapBlockBytes(t.buckets.get());
+            m.pointerBytes += t.size * sizeof(Node*);
+            for (size_t i = from; i < to; i++) {
+                for (const Node* curr = t.buckets[i]; curr; curr = curr->next) {
+                    size_t block = heapBlockBytes(curr);
+                    size_t keyHeap = ownedHeapBytes(curr->key);
+                    m.keys++;
+                    m.nodes++;
+                    m.totalBytes += block + keyHeap;
+                    m.pointerBytes += sizeof(curr->next);
+                    m.slackBytes += block - sizeof(Node);
+                    m.keyHeapBytes += keyHeap;
+                }
+            }
+        };
+        add(table_, 0, readyBuckets());
+        if (migrating()) add(old_, migrated_, old_.size);
+        m.keySlots = m.buckets;
+        return m;
+    }
+
+private:
+    Table table_;
+    Table old_;            // array lama selama migrasi, kosong selain itu
+    size_t migrated_ = 0;  // bucket lama [0, migrated_) sudah dipindah
+    size_t size_ = 0;
+    size_t resizes_ = 0;
+    double maxLoadFactor_;
+    size_t migrateStep_;
+    Hash hash_;
+
+    // Bucket baru [0, readyBuckets()) sudah dinolkan; sisanya belum disentuh.
+    size_t readyBuckets() const { return migrating() ? 2 * migrated_ : table_.size; }
+
+    Node** bucketFor(uint64_t hash) {
+        if (migrating()) {
+            size_t i = old_.index(hash);
+            if (i >= migrated_) return &old_.buckets[i];
+        }
+        return &table_.buckets[table_.index(hash)];
+    }
+
+    void startResize() {
+        // Migrasi sebelumnya harus selesai dulu; dengan migrateStep >= 1 ini
+        // hampir tidak pernah terjadi karena tabel baru 2x lebih besar.
+        if (migrating()) migrate(old_.size);
+        old_ = std::move(table_);
+        table_.allocate(old_.size * 2, false);
+        migrated_ = 0;
+        resizes_++;
+        if (migrateStep_ == 0) migrate(old_.size);
+    }
+
+    void step() {
+        if (migrating()) migrate(migrateStep_);
+    }
+
+    // Pindahkan paling banyak `count` bucket lama. Urutan node di chain baru
+    // tidak dipertahankan (tidak berpengaruh pada hasil).
+    void migrate(size_t count) {
+        size_t end = std::min(old_.size, migrated_ + count);
+        for (; migrated_ < end; migrated_++) {
+            table_.buckets[2 * migrated_] = nullptr;
+            table_.buckets[2 * migrated_ + 1] = nullptr;
+            Node* curr = old_.buckets[migrated_];
+            while (curr) {
+                Node* next = curr->next;
+                Node*& head = table_.buckets[table_.index(curr->hash)];
+                curr->next = head;
+                head = curr;
+                curr = next;
+            }
+            old_.buckets[migrated_] = nullptr;
+        }
+        if (migrated_ == old_.size) {
+            old_.buckets.reset();
+            old_.size = 0;
+        }
+    }
+
+    static void freeChains(Table& t, size_t from, size_t to) {
+        for (size_t i = from; i < to; i++) {
+            Node* curr = t.buckets[i];
+            while (curr) {
+                Node* next = curr->next;
+                delete curr;
+                curr = next;
+            }
+        }
+    }
+};
+
+#endif
@@ -2,6 +2,18 @@
 #include <vector>
 #include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <climits>
+#include <string>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <iomanip>
+#include <thread>
+#include "hashtable_open.h"
+#include "data_loader.h"
+#include "bench_util.h"
+#include "memory_stats.h"
 
 using namespace std;
 using namespace std::chrono;
@@ -29,6 +41,12 @@ void insert(int key) {
     table[index] = newNode;
 }
 
+// Insert tanpa cek duplikat, hanya untuk data yang sudah pasti unik
+void insertDistinct(int key) {
+    int index = hashFunction(key);
+    table[index] = new Node{key, table[index]};
+}
+
 bool search(int key, int& iterations) {
     int index = hashFunction(key);
     Node* curr = table[index];
@@ -76,6 +94,8 @@ bool remove(int key, int& iterations) {
     return false;
 }
 
+// Node lama dipakai ulang: key ditulis ulang di tempat kalau bucket-nya
+// sama, selain itu node dipindah ke kepala bucket baru tanpa delete/new.
 bool update(int oldKey, int newKey, int& iterations) {
     iterations = 0;
     int search_iters = 0;
@@ -84,32 +104,144 @@ bool update(int oldKey, int newKey, int& iterations) {
         return false;
     }
 
-    if (remove(oldKey, iterations)) {
-        insert(newKey);
-        iterations += search_iters;
-        return true;
-    } else {
+    int index = hashFunction(oldKey);
+    Node* curr = table[index];
+    Node* prev = NULL;
+    while (curr != NULL) {
+        iterations++;
+        if (curr->key == oldKey) break;
+        prev = curr;
+        curr = curr->next;
+    }
+    if (curr == NULL) {
         cout << "Gagal update: Nilai lama " << oldKey << " tidak ada.\n";
         return false;
     }
+
+    curr->key = newKey;
+    int newIndex = hashFunction(newKey);
+    if (newIndex != index) {
+        if (prev == NULL) {
+            table[index] = curr->next;
+        } else {
+            prev->next = curr->next;
+        }
+        curr->next = table[newIndex];
+        table[newIndex] = curr;
+    }
+    iterations += search_iters;
+    return true;
 }
 
-int main() {
-    for (int i = 0; i < 26; i++) {
+// Bandingkan panjang probe chaining (TABLE_SIZE tetap) vs open addressing
+// pada n key acak yang unik.
+int compareEngines(int n) {
+    vector<int> pool(2 * (size_t)n);
+    iota(pool.begin(), pool.end(), 0);
+    mt19937 rng(42);
+    shuffle(pool.begin(), pool.end(), rng);
+
+    OpenHashTable<int> open;
+    for (int i = 0; i < n; i++) {
+        insertDistinct(pool[i]);
+        open.insert(pool[i]);
+    }
+
+    // Chaining di TABLE_SIZE = 26 terlalu lambat untuk mencari semua key,
+    // jadi hanya sampel yang diukur.
+    int samples = min(n, 1000);
+    uniform_int_distribution<int> pick(0, n - 1);
+    vector<int> hits(samples), misses(samples);
+    for (int i = 0; i < samples; i++) {
+        hits[i] = pool[pick(rng)];
+        misses[i] = pool[n + pick(rng)];
+    }
+
+    cout << fixed << setprecision(2);
+    cout << "Perbandingan " << n << " key, " << samples << " sampel pencarian\n";
+    cout << "Open addressing: kapasitas " << open.capacity() << ", load factor "
+         << open.loadFactor() << ", probe terpanjang " << open.maxProbeLength() << "\n";
+    printMemoryStats("chaining", chainedTableStats(table, TABLE_SIZE));
+    printMemoryStats("open addressing", open.memoryStats());
+    cout << "\n";
+
+    auto measure = [&](const char* name, const vector<int>& keys, auto searchFn) {
+        long long total = 0;
+        int longest = 0, iterations = 0;
+        auto start = high_resolution_clock::now();
+        for (int k : keys) {
+            searchFn(k, iterations);
+            total += iterations;
+            longest = max(longest, iterations);
+        }
+        auto end = high_resolution_clock::now();
+        auto ns = duration_cast<nanoseconds>(end - start).count();
+        cout << name << ": rata-rata " << (double)total / keys.size() << " iterasi, maksimum "
+             << longest << " iterasi, " << (double)ns / keys.size() << " ns/search\n";
+    };
+
+    auto chained = [](int k, int& it) { return search(k, it); };
+    auto openAddr = [&open](int k, int& it) { return open.search(k, it); };
+    measure("Chaining (hit)  ", hits, chained);
+    measure("Open addr (hit) ", hits, openAddr);
+    measure("Chaining (miss) ", misses, chained);
+    measure("Open addr (miss)", misses, openAddr);
+    return 0;
+}
+
+// --parallel: bangun OpenHashTable dari key file (atau n key acak kalau
+// argumen bukan file) satu per satu, lalu lewat buildParallel dengan 1, 2,
+// 4, ... sampai maxThreads thread.
+int parallelBuild(const char* source, unsigned maxThreads) {
+    vector<BuildStep> serial = {
+        {"insert satu per satu", [](const vector<int>& keys) {
+             OpenHashTable<int> table;
+             for (int k : keys) table.insert(k);
+             return table.size();
+         }},
+    };
+    return parallelBuildBench(source, maxThreads, serial, [](const vector<int>& keys, unsigned t) {
+        OpenHashTable<int> table;
+        table.buildParallel(keys.begin(), keys.end(), t);
+        return table.size();
+    });
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 0; i < TABLE_SIZE; i++) {
         table[i] = NULL;
     }
 
-    FILE* file_pointer = fopen("data/int500hash.txt", "r");
-    if (file_pointer == NULL) {
-        perror("Error: Tidak dapat membuka file txt");
-        return 1; 
+    if (argc == 3 && string(argv[1]) == "--compare") {
+        // Key diambil dari 0..2n-1, jadi n juga dibatasi agar 2n muat di int.
+        char* end;
+        long n = strtol(argv[2], &end, 10);
+        if (end == argv[2] || *end != '\0' || n < 1 || n > INT_MAX / 2) {
+            cerr << "Usage: " << argv[0] << " --compare <n>   (1 <= n <= " << INT_MAX / 2 << ")\n";
+            return 1;
+        }
+        return compareEngines((int)n);
+    }
+    if ((argc == 3 || argc == 4) && string(argv[1]) == "--parallel") {
+        unsigned threads;
+        if (!parseThreadCount(argc == 4 ? argv[3] : nullptr, threads)) {
+            cerr << "Usage: " << argv[0] << " --parallel <file.txt|n> [threads]   (1 <= threads <= "
+                 << MAX_BENCH_THREADS << ")\n";
+            return 1;
+        }
+        return parallelBuild(argv[2], threads);
     }
 
-    int key;
-    while (fscanf(file_pointer, "%d", &key) == 1) {
-        insert(key);
+    const char* filename = "data/int500hash.txt";
+    auto startLoad = steady_clock::now();
+    DataFile file;
+    if (!file.open(filename)) {
+        perror("Error: Tidak dapat membuka file txt");
+        return 1; 
     }
-    fclose(file_pointer);
+    size_t loaded = parseInts(file.text(), [](int key) { insert(key); });
+    printLoadStats(filename, file.bytes(), loaded, steady_clock::now() - startLoad);
+    printMemoryStats("hash table chaining", chainedTableStats(table, TABLE_SIZE));
 
     cout << "Hash table:\n";
     display();
@@ -0,0 +1,404 @@
+#ifndef HASHTABLE_OPEN_H
+#define HASHTABLE_OPEN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "hash_function.h"
+#include "memory_stats.h"
+#include "parallel_util.h"
+#include "value_storage.h"
+
+// Hash table open addressing dengan Robin Hood probing di atas array datar
+// berukuran pangkat dua. Semantik insert/search/remove/update sama dengan
+// versi chaining, dan `iterations` menghitung jumlah slot yang diperiksa.
+//
+// Dengan Value selain BPlusEmpty tabel menjadi map: value kecil disimpan di
+// slot, value besar di heap (lihat value_storage.h), dan get/put/erase
+// membaca atau menulis value dalam satu kali probe.
+template <typename Key, typename Value = BPlusEmpty, typename Hash = KeyHash<Key>>
+class OpenHashTable {
+public:
+    explicit OpenHashTable(size_t initialCapacity = 16, double maxLoadFactor = 0.75)
+        : maxLoadFactor_(maxLoadFactor) {
+        size_t cap = 8;
+        while (cap < initialCapacity) cap <<= 1;
+        allocate(cap);
+    }
+
+    bool insert(const Key& key, const Value& value = Value()) {
+        reserveOne();
+        bool inserted;
+        insertNoGrow(key, value, inserted);
+        return inserted;
+    }
+
+    // Insert, atau timpa value kalau key sudah ada. Referensi berlaku sampai
+    // operasi tulis berikutnya.
+    Value& put(const Key& key, const Value& value) {
+        reserveOne();
+        bool inserted;
+        size_t idx = insertNoGrow(key, value, inserted);
+        if (!inserted) slots_[idx].value() = value;
+        return slots_[idx].value();
+    }
+
+    // Pointer ke value milik key, nullptr kalau tidak ada.
+    Value* get(const Key& key) {
+        int iterations = 0;
+        size_t idx = findSlot(key, iterations);
+        return idx == NOT_FOUND ? nullptr : &slots_[idx].value();
+    }
+
+    const Value* get(const Key& key) const { return const_cast<OpenHashTable*>(this)->get(key); }
+
+    // Hapus key; kalau `removed` diberikan, value-nya dipindah ke sana.
+    bool erase(const Key& key, Value* removed = nullptr) {
+        int iterations = 0;
+        size_t idx = findSlot(key, iterations);
+        if (idx == NOT_FOUND) return false;
+        if (removed) *removed = std::move(slots_[idx].value());
+        eraseSlot(idx);
+        return true;
+    }
+
+    bool search(const Key& key, int& iterations) const {
+        iterations = 0;
+        size_t idx = homeIndex(key);
+        for (uint32_t dist = 1;; dist++) {
+            iterations++;
+            const Slot& s = slots_[idx];
+            // Robin Hood: begitu slot lebih "kaya" dari key yang dicari,
+            // key pasti tidak ada di tabel.
+            if (s.dist < dist) return false;
+            if (s.dist == dist && s.key == key) return true;
+            idx = (idx + 1) & mask_;
+        }
+    }
+
+    // Cari n key sekaligus; found[i] diisi hasil untuk keys[i]. Key diproses
+    // per grup: slot awal semua key di grup di-prefetch dulu, baru diprobe,
+    // jadi cache miss antar key saling tumpang tindih.
+    void searchBatch(const Key* keys, size_t n, bool* found) const {
+        size_t home[BATCH_GROUP];
+        for (size_t base = 0; base < n; base += BATCH_GROUP) {
+            size_t g = std::min(BATCH_GROUP, n - base);
+            for (size_t i = 0; i < g; i++) {
+                home[i] = homeIndex(keys[base + i]);
+                __builtin_prefetch(&slots_[home[i]]);
+            }
+            for (size_t i = 0; i < g; i++) found[base + i] = probe(keys[base + i], home[i]);
+        }
+    }
+
+    bool remove(const Key& key, int& iterations) {
+        iterations = 0;
+        size_t idx = findSlot(key, iterations);
+        if (idx == NOT_FOUND) return false;
+        eraseSlot(idx);
+        return true;
+    }
+
+    // Kalau newKey punya slot awal yang sama dengan oldKey, jarak probe-nya
+    // juga sama, jadi key cukup ditimpa di slotnya. Selain itu slot lama
+    // dihapus dan newKey disisipkan tanpa cek grow (jumlah key tetap).
+    bool update(const Key& oldKey, const Key& newKey, int& iterations) {
+        iterations = 0;
+        int search_iters = 0;
+
+        if (search(newKey, search_iters)) {
+            return false;
+        }
+
+        size_t idx = findSlot(oldKey, iterations);
+        if (idx == NOT_FOUND) return false;
+        iterations += search_iters;
+        if (homeIndex(newKey) == homeIndex(oldKey)) {
+            slots_[idx].key = newKey;
+        } else {
+            Stored value = std::move(slots_[idx].stored());
+            eraseSlot(idx);
+            bool inserted;
+            insertNoGrow(newKey, std::move(value), inserted);
+        }
+        return true;
+    }
+
+    // Sisipkan key [first, last) (iterator random access) dengan `threads`
+    // thread. Index slot adalah bit atas hash, jadi partisi menurut prefix
+    // hash = blok slot yang berdampingan. Setiap thread menghitung histogram
+    // partisi potongan inputnya, lalu menyalin key-nya ke buffer datar yang
+    // sudah dialokasikan (offset dari prefix sum, tanpa kunci); kemudian
+    // setiap partisi disisipkan ke blok slotnya sendiri oleh satu thread.
+    // Key yang probe-nya melewati ujung blok dikumpulkan dan disisipkan
+    // serial di akhir (jarang, karena load <= maxLoadFactor). Tabel yang
+    // tidak kosong atau input kecil diisi serial. Duplikat dilewati;
+    // mengembalikan jumlah key yang disisipkan.
+    template <typename It>
+    size_t buildParallel(It first, It last, unsigned threads) {
+        size_t n = last - first;
+        size_t before = size_;
+        size_t cap = slots_.size();
+        while (size_ + n > cap * maxLoadFactor_) cap <<= 1;
+
+        int partBits = 0;
+        while ((1u << partBits) < threads * PARTITIONS_PER_THREAD) partBits++;
+        int capBits = 0;
+        while ((size_t(1) << capBits) < cap) capBits++;
+        partBits = std::min(partBits, capBits - MIN_REGION_BITS);
+        if (size_ != 0 || threads <= 1 || partBits <= 0) {
+            if (cap != slots_.size()) rehash(cap);
+            bool inserted;
+            for (It it = first; it != last; ++it) insertNoGrow(*it, Stored(Value()), inserted);
+            return size_ - before;
+        }
+        allocate(cap);
+        size_t parts = size_t(1) << partBits;
+        int partShift = 64 - partBits;
+        size_t region = cap >> partBits;
+        auto chunk = [&](unsigned t) { return std::make_pair(n * t / threads, n * (t + 1) / threads); };
+
+        // 1. Histogram partisi per thread.
+        std::vector<std::vector<size_t>> offsets(threads, std::vector<size_t>(parts, 0));
+        runThreads(threads, [&](unsigned t) {
+            auto range = chunk(t);
+            for (size_t i = range.first; i < range.second; i++) offsets[t][hash_(first[i]) >> partShift]++;
+        });
+
+        // 2. Prefix sum: partisi berurutan, di dalamnya potongan thread 0, 1, ...
+        std::vector<size_t> partStart(parts + 1, 0);
+        size_t pos = 0;
+        for (size_t p = 0; p < parts; p++) {
+            partStart[p] = pos;
+            for (unsigned t = 0; t < threads; t++) {
+                size_t c = offsets[t][p];
+                offsets[t][p] = pos;
+                pos += c;
+            }
+        }
+        partStart[parts] = pos;
+
+        // 3. Scatter ke buffer datar; setiap thread menulis ke rentangnya sendiri.
+        std::vector<Key> scattered(n);
+        runThreads(threads, [&](unsigned t) {
+            auto range = chunk(t);
+            for (size_t i = range.first; i < range.second; i++) {
+                scattered[offsets[t][hash_(first[i]) >> partShift]++] = first[i];
+            }
+        });
+
+        // 4. Bangun setiap partisi di blok slotnya.
+        std::vector<std::vector<Key>> spill(threads);
+        runThreads(threads, [&](unsigned t) {
+            for (size_t p = t; p < parts; p += threads) {
+                for (size_t i = partStart[p]; i < partStart[p + 1]; i++) {
+                    insertInRegion(std::move(scattered[i]), (p + 1) * region, spill[t]);
+                }
+            }
+        });
+
+        // 5. Sambungkan: hitung slot terisi, lalu sisipkan limpahan serial.
+        size_ = 0;
+        for (const Slot& s : slots_) size_ += s.dist != 0;
+        bool inserted;
+        for (std::vector<Key>& keys : spill) {
+            for (Key& key : keys) insertNoGrow(std::move(key), Stored(Value()), inserted);
+        }
+        return size_;
+    }
+
+    // Panggil fn(key) untuk setiap key, dalam urutan slot (tidak terurut).
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Slot& s : slots_) {
+            if (s.dist != 0) fn(s.key);
+        }
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return slots_.size(); }
+    double loadFactor() const { return static_cast<double>(size_) / slots_.size(); }
+
+    // Panjang probe terpanjang di tabel (dist maksimum).
+    uint32_t maxProbeLength() const {
+        uint32_t longest = 0;
+        for (const Slot& s : slots_) {
+            if (s.dist > longest) longest = s.dist;
+        }
+        return longest;
+    }
+
+    // Satu array slot tanpa pointer; slot kosong dan capacity vector yang
+    // belum terpakai dihitung sebagai slack.
+    MemoryStats memoryStats() const {
+        MemoryStats m;
+        m.keys = size_;
+        m.buckets = slots_.size();
+        m.keySlots = slots_.size();
+        m.totalBytes = heapBlockBytes(slots_.data());
+        m.slackBytes = m.totalBytes - size_ * sizeof(Slot);
+        for (const Slot& s : slots_) {
+            if (s.dist != 0) m.keyHeapBytes += ownedHeapBytes(s.key) + ownedHeapBytes(s.stored());
+        }
+        m.totalBytes += m.keyHeapBytes;
+        return m;
+    }
+
+private:
+    static constexpr size_t BATCH_GROUP = 16;
+    static constexpr size_t NOT_FOUND = SIZE_MAX;
+    static constexpr unsigned PARTITIONS_PER_THREAD = 8;
+    static constexpr int MIN_REGION_BITS = 10;  // blok partisi minimal 1024 slot
+
+    using Stored = typename std::conditional<std::is_same<Value, BPlusEmpty>::value, BPlusEmpty,
+                                             StoredValue<Value>>::type;
+
+    // Value disimpan di base class, jadi untuk set (BPlusEmpty) slot tetap
+    // sebesar key + dist.
+    struct SlotValue {
+        Stored item;
+    };
+
+    struct Slot : std::conditional<std::is_same<Value, BPlusEmpty>::value, BPlusEmpty, SlotValue>::type {
+        Key key;
+        uint32_t dist;  // 0 = kosong, selain itu jarak probe + 1
+
+        Slot() : key(), dist(0) {}
+        Slot(Key k, Stored v, uint32_t d) : key(std::move(k)), dist(d) { stored() = std::move(v); }
+
+        Stored& stored() {
+            if constexpr (std::is_same<Value, BPlusEmpty>::value) {
+                return *this;
+            } else {
+                return this->item;
+            }
+        }
+        const Stored& stored() const { return const_cast<Slot*>(this)->stored(); }
+        Value& value() { return loadValue(stored()); }
+    };
+
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+    int shift_ = 0;
+    size_t size_ = 0;
+    double maxLoadFactor_;
+    Hash hash_;
+
+    void allocate(size_t cap) {
+        slots_.assign(cap, Slot());
+        mask_ = cap - 1;
+        int bits = 0;
+        while ((size_t(1) << bits) < cap) bits++;
+        shift_ = 64 - bits;
+        size_ = 0;
+    }
+
+    bool probe(const Key& key, size_t idx) const {
+        for (uint32_t dist = 1;; dist++) {
+            const Slot& s = slots_[idx];
+            if (s.dist < dist) return false;
+            if (s.dist == dist && s.key == key) return true;
+            idx = (idx + 1) & mask_;
+        }
+    }
+
+    size_t findSlot(const Key& key, int& iterations) const {
+        size_t idx = homeIndex(key);
+        for (uint32_t dist = 1;; dist++) {
+            iterations++;
+            const Slot& s = slots_[idx];
+            if (s.dist < dist) return NOT_FOUND;
+            if (s.dist == dist && s.key == key) return idx;
+            idx = (idx + 1) & mask_;
+        }
+    }
+
+    // Backward shift deletion: geser entri berikutnya mundur satu slot,
+    // jadi tidak perlu tombstone.
+    void eraseSlot(size_t idx) {
+        size_t next = (idx + 1) & mask_;
+        while (slots_[next].dist > 1) {
+            slots_[idx] = std::move(slots_[next]);
+            slots_[idx].dist--;
+            idx = next;
+            next = (next + 1) & mask_;
+        }
+        slots_[idx] = Slot();
+        size_--;
+    }
+
+    // Bit atas hash dipakai sebagai index awal.
+    size_t homeIndex(const Key& key) const {
+        return static_cast<size_t>(hash_(key) >> shift_) & mask_;
+    }
+
+    void reserveOne() {
+        if ((size_ + 1) > static_cast<size_t>(slots_.size() * maxLoadFactor_)) {
+            rehash(slots_.size() * 2);
+        }
+    }
+
+    // Mengembalikan slot tempat key berada (baru disisipkan atau sudah ada).
+    size_t insertNoGrow(Key key, Stored value, bool& inserted) {
+        Slot cur(std::move(key), std::move(value), 1);
+        size_t idx = homeIndex(cur.key);
+        size_t placed = NOT_FOUND;
+        while (true) {
+            Slot& s = slots_[idx];
+            if (s.dist == 0) {
+                s = std::move(cur);
+                size_++;
+                inserted = true;
+                return placed == NOT_FOUND ? idx : placed;
+            }
+            if (placed == NOT_FOUND && s.dist == cur.dist && s.key == cur.key) {
+                inserted = false;
+                return idx;
+            }
+            if (s.dist < cur.dist) {
+                std::swap(s, cur);
+                if (placed == NOT_FOUND) placed = idx;
+            }
+            cur.dist++;
+            idx = (idx + 1) & mask_;
+        }
+    }
+
+    // insertNoGrow yang berhenti di ujung blok slot partisinya (`hi`, tidak
+    // memutar ke awal tabel), dipakai buildParallel: thread lain menulis blok
+    // lain. Entri yang terdorong sampai ujung blok, entah key baru atau yang
+    // tergeser, masuk `spill`.
+    void insertInRegion(Key key, size_t hi, std::vector<Key>& spill) {
+        Slot cur(std::move(key), Stored(Value()), 1);
+        size_t idx = homeIndex(cur.key);
+        bool swapped = false;
+        for (; idx < hi; idx++, cur.dist++) {
+            Slot& s = slots_[idx];
+            if (s.dist == 0) {
+                s = std::move(cur);
+                return;
+            }
+            if (!swapped && s.dist == cur.dist && s.key == cur.key) return;
+            if (s.dist < cur.dist) {
+                std::swap(s, cur);
+                swapped = true;
+            }
+        }
+        spill.push_back(std::move(cur.key));
+    }
+
+    void rehash(size_t newCap) {
+        std::vector<Slot> old = std::move(slots_);
+        allocate(newCap);
+        bool inserted;
+        for (Slot& s : old) {
+            if (s.dist != 0) insertNoGrow(std::move(s.key), std::move(s.stored()), inserted);
+        }
+    }
+};
+
+#endif
@@ -4,42 +4,64 @@
 #include <chrono>
 #include <cstdio>
 #include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <iomanip>
+#include "hash_function.h"
+#include "data_loader.h"
+#include "memory_stats.h"
+#include "hashtable_arena.h"
 
 using namespace std;
 using namespace std::chrono;
 
 struct Node {
     string key;
+    uint64_t hash;
     Node* next;
 };
 
 const int TABLE_SIZE = 26;
 Node* table[TABLE_SIZE];
+uint64_t hashSeed = 0;
 
-int hashFunction(const string& key) {
+// Hash lama (hanya huruf pertama), disimpan untuk perbandingan distribusi chain
+int firstLetterHash(const string& key) {
     int sum = 0;
     sum += key[0];
     return sum % TABLE_SIZE;
 }
 
+uint64_t keyHash(const string& key) {
+    return hashString(key, hashSeed);
+}
+
+int hashFunction(uint64_t hash) {
+    return hash % TABLE_SIZE;
+}
+
+// Hash yang di-cache di Node dibandingkan dulu, string == hanya dijalankan
+// kalau hash-nya sama.
 void insert(const string& key) {
-    int index = hashFunction(key);
+    uint64_t hash = keyHash(key);
+    int index = hashFunction(hash);
     Node* curr = table[index];
     while (curr != NULL) {
-        if (curr->key == key) return;
+        if (curr->hash == hash && curr->key == key) return;
         curr = curr->next;
     }
-    Node* newNode = new Node{key, table[index]};
+    Node* newNode = new Node{key, hash, table[index]};
     table[index] = newNode;
 }
 
 bool search(const string& key, int& iterations) {
-    int index = hashFunction(key);
+    uint64_t hash = keyHash(key);
+    int index = hashFunction(hash);
     Node* curr = table[index];
     iterations = 0;
     while (curr != NULL) {
         iterations++;
-        if (curr->key == key) return true;
+        if (curr->hash == hash && curr->key == key) return true;
         curr = curr->next;
     }
     return false;
@@ -58,14 +80,15 @@ void display() {
 }
 
 bool remove(const string& key, int& iterations) {
-    int index = hashFunction(key);
+    uint64_t hash = keyHash(key);
+    int index = hashFunction(hash);
     Node* curr = table[index];
     Node* prev = NULL;
     iterations = 0;
 
     while (curr != NULL) {
         iterations++;
-        if (curr->key == key) {
+        if (curr->hash == hash && curr->key == key) {
             if (prev == NULL) { 
                 table[index] = curr->next;
             } else {
@@ -80,6 +103,9 @@ bool remove(const string& key, int& iterations) {
     return false;
 }
 
+// Node lama dipakai ulang: key (dan hash) ditulis ulang di tempat kalau
+// bucket-nya sama, selain itu node dipindah ke kepala bucket baru tanpa
+// delete/new.
 bool update(const string& oldKey, const string& newKey, int& iterations) {
     iterations = 0;
     int search_iters = 0;
@@ -88,33 +114,197 @@ bool update(const string& oldKey, const string& newKey, int& iterations) {
         return false;
     }
 
-    if (remove(oldKey, iterations)) {
-        insert(newKey);
-        iterations += search_iters;
-        return true;
-    } else {
-        return false;
+    uint64_t hash = keyHash(oldKey);
+    int index = hashFunction(hash);
+    Node* curr = table[index];
+    Node* prev = NULL;
+    while (curr != NULL) {
+        iterations++;
+        if (curr->hash == hash && curr->key == oldKey) break;
+        prev = curr;
+        curr = curr->next;
     }
+    if (curr == NULL) return false;
+
+    curr->key = newKey;
+    curr->hash = keyHash(newKey);
+    int newIndex = hashFunction(curr->hash);
+    if (newIndex != index) {
+        if (prev == NULL) {
+            table[index] = curr->next;
+        } else {
+            prev->next = curr->next;
+        }
+        curr->next = table[newIndex];
+        table[newIndex] = curr;
+    }
+    iterations += search_iters;
+    return true;
+}
+
+// Ringkasan distribusi panjang chain untuk satu fungsi hash
+template <typename BucketFn>
+void printChainStats(const char* name, const vector<string>& keys, BucketFn bucketOf) {
+    vector<long long> length(TABLE_SIZE, 0);
+    for (const string& k : keys) length[bucketOf(k)]++;
+
+    long long shortest = keys.size(), longest = 0, empty = 0;
+    double sumSq = 0, expectedHit = 0;
+    double mean = (double)keys.size() / TABLE_SIZE;
+    for (long long len : length) {
+        shortest = min(shortest, len);
+        longest = max(longest, len);
+        if (len == 0) empty++;
+        sumSq += (len - mean) * (len - mean);
+        expectedHit += len * (len + 1) / 2.0;
+    }
+
+    cout << "  " << name << ": kosong " << empty << ", min " << shortest << ", maks " << longest
+         << ", rata-rata " << mean << ", stddev " << sqrt(sumSq / TABLE_SIZE)
+         << ", rata-rata iterasi search (hit) " << expectedHit / keys.size() << "\n";
+    cout << "    panjang chain:";
+    for (long long len : length) cout << " " << len;
+    cout << "\n";
+}
+
+// Mode benchmark: distribusi chain sebelum (huruf pertama) dan sesudah (hash penuh)
+int chainBenchmark(const char* filename) {
+    DataFile file;
+    if (!file.open(filename)) {
+        cerr << "Error membuka file " << filename << endl;
+        return 1;
+    }
+    vector<string> names;
+    parseWords(file.text(), [&](string_view name) { names.emplace_back(name); });
+    if (names.empty()) {
+        cerr << "File " << filename << " kosong\n";
+        return 1;
+    }
+
+    cout << fixed << setprecision(2);
+    auto report = [](const vector<string>& keys) {
+        printChainStats("Sebelum (huruf pertama)", keys, firstLetterHash);
+        printChainStats("Sesudah (hash penuh)   ", keys,
+                        [](const string& k) { return hashFunction(keyHash(k)); });
+    };
+
+    cout << filename << " (" << names.size() << " nama)\n";
+    report(names);
+
+    // Set lebih besar: nama dari file + akhiran angka, distribusi huruf pertama tetap
+    for (size_t n : {10000, 100000, 1000000}) {
+        vector<string> generated;
+        generated.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            generated.push_back(names[i % names.size()] + to_string(i / names.size()));
+        }
+        cout << "\nGenerated (" << n << " nama)\n";
+        report(generated);
+    }
+    return 0;
 }
 
-int main() {
+void clearTable() {
     for (int i = 0; i < TABLE_SIZE; i++) {
+        Node* curr = table[i];
+        while (curr != NULL) {
+            Node* next = curr->next;
+            delete curr;
+            curr = next;
+        }
         table[i] = NULL;
     }
+}
 
-    FILE* file_pointer = fopen("data/string500hash.txt", "r");
-    if (file_pointer == NULL) {
-        perror("Error: Tidak dapat membuka file nilai.txt");
-        return 1; 
+// Mode arena: node per key (chaining di atas) dibandingkan dengan
+// StringArenaTable, sekali dengan kapasitas yang langsung cukup untuk semua
+// key dan sekali dengan resize otomatis dari 1024 slot. Dilaporkan waktu
+// load, waktu search, dan footprint memori.
+int arenaBenchmark(const char* filename) {
+    DataFile file;
+    if (!file.open(filename)) {
+        cerr << "Error membuka file " << filename << endl;
+        return 1;
     }
-    
-   
-    char temp[256];
-    while (fscanf(file_pointer, "%s", temp) == 1) {
-        insert(string(temp));  
+    vector<string> names;
+    parseWords(file.text(), [&](string_view name) { names.emplace_back(name); });
+    if (names.empty()) {
+        cerr << "File " << filename << " kosong\n";
+        return 1;
+    }
+
+    cout << fixed << setprecision(2);
+    for (size_t n : {names.size(), (size_t)100000}) {
+        vector<string> keys;
+        keys.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            keys.push_back(n == names.size() ? names[i] : names[i % names.size()] + to_string(i / names.size()));
+        }
+        vector<string> probes;
+        for (size_t i = 0; i < min(n, (size_t)1000); i++) probes.push_back(keys[(i * 7919) % n]);
+
+        cout << "\n" << n << " nama, " << probes.size() << " sampel search\n";
+        auto report = [&](const char* name, auto load, auto searchFn, auto stats) {
+            auto start = steady_clock::now();
+            load();
+            double loadNs = (double)duration_cast<nanoseconds>(steady_clock::now() - start).count() / n;
+            int iterations = 0;
+            size_t found = 0;
+            start = steady_clock::now();
+            for (const string& p : probes) found += searchFn(p, iterations);
+            double searchNs = (double)duration_cast<nanoseconds>(steady_clock::now() - start).count() / probes.size();
+            cout << "  " << left << setw(26) << name << right << setw(10) << loadNs << " ns/insert"
+                 << setw(12) << searchNs << " ns/search  (" << found << " ditemukan)\n";
+            printMemoryStats(name, stats());
+        };
+
+        clearTable();
+        report("chaining (node per key)", [&] { for (const string& k : keys) insert(k); },
+               [](const string& k, int& it) { return search(k, it); },
+               [] { return chainedTableStats(table, TABLE_SIZE); });
+        clearTable();
+
+        StringArenaTable sizedArena(n * 4 / 3 + 1, 0.75, hashSeed);
+        report("arena (tanpa resize)", [&] { for (const string& k : keys) sizedArena.insert(k); },
+               [&](const string& k, int& it) { return sizedArena.search(k, it); },
+               [&] { return sizedArena.memoryStats(); });
+
+        StringArenaTable arena(1024, 0.75, hashSeed);
+        report("arena (resize)", [&] { for (const string& k : keys) arena.insert(k); },
+               [&](const string& k, int& it) { return arena.search(k, it); },
+               [&] { return arena.memoryStats(); });
+
+        // Hapus separuh key: byte mati di arena memicu compaction.
+        int iterations = 0;
+        for (size_t i = 0; i < n; i += 2) arena.remove(keys[i], iterations);
+        cout << "  setelah hapus separuh: arena " << arena.arenaBytes() << " byte, mati " << arena.deadBytes()
+             << " byte, " << arena.compactions() << " compaction\n";
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        table[i] = NULL;
+    }
+
+    if (argc == 3 && string(argv[1]) == "--chains") {
+        return chainBenchmark(argv[2]);
+    }
+    if (argc == 3 && string(argv[1]) == "--arena") {
+        return arenaBenchmark(argv[2]);
     }
 
-    fclose(file_pointer);
+    const char* filename = "data/string500hash.txt";
+    auto startLoad = steady_clock::now();
+    DataFile file;
+    if (!file.open(filename)) {
+        perror("Error: Tidak dapat membuka file nilai.txt");
+        return 1; 
+    }
+    size_t loaded = parseWords(file.text(), [](string_view name) { insert(string(name)); });
+    printLoadStats(filename, file.bytes(), loaded, steady_clock::now() - startLoad);
+    printMemoryStats("hash table chaining", chainedTableStats(table, TABLE_SIZE));
 
     cout << "Hash table awal:\n";
     display();
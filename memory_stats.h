@@ -0,0 +1,89 @@
+#ifndef MEMORY_STATS_H
+#define MEMORY_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include <malloc.h>
+
+// Akuntansi memori per struktur. Setiap struktur mengisi MemoryStats dengan
+// menelusuri node/slot miliknya sendiri, jadi angka bisa dilaporkan tanpa
+// mengganti operator new global (bench_bplus tetap memakai penghitung heap
+// global sebagai pembanding).
+struct MemoryStats {
+    size_t keys = 0;
+    size_t totalBytes = 0;    // blok heap (termasuk header malloc) + array tetap milik struktur
+    size_t nodes = 0;         // node chain / node tree (leaf + internal)
+    size_t leaves = 0;        // khusus tree
+    size_t buckets = 0;       // bucket atau slot tabel
+    size_t keySlots = 0;      // kapasitas key; fill factor = keys / keySlots
+    size_t pointerBytes = 0;  // next, parent, anak, dan array bucket
+    size_t slackBytes = 0;    // dialokasikan tapi tidak berisi data (slot kosong, capacity vector)
+    size_t keyHeapBytes = 0;  // isi key di luar node (string panjang)
+
+    double bytesPerKey() const { return keys ? (double)totalBytes / keys : 0; }
+    double fillFactor() const { return keySlots ? (double)keys / keySlots : 0; }
+};
+
+// Byte yang benar-benar diambil dari heap untuk blok `p`: ukuran yang bisa
+// dipakai ditambah header chunk glibc.
+inline size_t heapBlockBytes(const void* p) {
+    return p ? malloc_usable_size(const_cast<void*>(p)) + sizeof(size_t) : 0;
+}
+
+// Byte heap di luar objek itu sendiri. Hanya std::string yang punya buffer
+// terpisah (kalau tidak muat di SSO).
+template <typename T>
+size_t ownedHeapBytes(const T&) {
+    return 0;
+}
+
+inline size_t ownedHeapBytes(const std::string& s) {
+    const char* data = s.data();
+    const char* self = reinterpret_cast<const char*>(&s);
+    bool inlineBuffer = data >= self && data < self + sizeof(std::string);
+    return inlineBuffer ? 0 : heapBlockBytes(data);
+}
+
+inline void printMemoryStats(const std::string& name, const MemoryStats& m, std::ostream& out = std::cout) {
+    auto pct = [&](size_t part) { return m.totalBytes ? 100.0 * part / m.totalBytes : 0.0; };
+    out << "Memori " << name << ": " << m.keys << " key, " << m.totalBytes << " byte ("
+        << m.bytesPerKey() << " byte/key)\n";
+    out << "  node " << m.nodes;
+    if (m.leaves) out << " (leaf " << m.leaves << ", internal " << m.nodes - m.leaves << ")";
+    if (m.buckets) out << ", bucket/slot " << m.buckets;
+    out << ", fill factor " << m.fillFactor() << "\n";
+    out << "  pointer " << m.pointerBytes << " byte (" << pct(m.pointerBytes) << "%), slack "
+        << m.slackBytes << " byte (" << pct(m.slackBytes) << "%)";
+    if (m.keyHeapBytes) out << ", key di heap " << m.keyHeapBytes << " byte";
+    out << "\n";
+}
+
+// Statistik untuk tabel chaining `Node* table[size]` di hashtable_*_2.cpp:
+// Node harus punya `key` dan `next`.
+template <typename NodeT>
+MemoryStats chainedTableStats(NodeT* const* table, size_t tableSize) {
+    MemoryStats m;
+    m.buckets = tableSize;
+    m.totalBytes = tableSize * sizeof(NodeT*);
+    m.pointerBytes = tableSize * sizeof(NodeT*);
+    for (size_t i = 0; i < tableSize; i++) {
+        for (const NodeT* curr = table[i]; curr; curr = curr->next) {
+            size_t block = heapBlockBytes(curr);
+            size_t keyHeap = ownedHeapBytes(curr->key);
+            m.keys++;
+            m.nodes++;
+            m.totalBytes += block + keyHeap;
+            m.pointerBytes += sizeof(curr->next);
+            m.slackBytes += block - sizeof(NodeT);
+            m.keyHeapBytes += keyHeap;
+        }
+    }
+    // Chaining tidak punya kapasitas tetap; satu node = satu key.
+    m.keySlots = m.keys;
+    return m;
+}
+
+#endif
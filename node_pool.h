@@ -0,0 +1,70 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Arena untuk node berukuran tetap. Memori diambil per chunk besar dan
+// node yang dilepas masuk free list, jadi split tidak memanggil `new`
+// satu per satu dan node yang bertetangga cenderung berdekatan di memori.
+template <typename T, size_t NodesPerChunk = 256>
+class NodePool {
+public:
+    NodePool() = default;
+    ~NodePool() {
+        for (void* chunk : chunks_) {
+            ::operator delete(chunk, std::align_val_t(alignof(T)));
+        }
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    template <typename... Args>
+    T* create(Args&&... args) {
+        void* mem;
+        if (freeList_) {
+            mem = freeList_;
+            freeList_ = freeList_->next;
+        } else {
+            if (used_ == NodesPerChunk || chunks_.empty()) {
+                chunks_.push_back(::operator new(sizeof(Slot) * NodesPerChunk,
+                                                 std::align_val_t(alignof(T))));
+                used_ = 0;
+            }
+            mem = static_cast<Slot*>(chunks_.back()) + used_++;
+        }
+        live_++;
+        return new (mem) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T* node) {
+        node->~T();
+        FreeSlot* slot = reinterpret_cast<FreeSlot*>(node);
+        slot->next = freeList_;
+        freeList_ = slot;
+        live_--;
+    }
+
+    size_t liveNodes() const { return live_; }
+    size_t reservedBytes() const { return chunks_.size() * sizeof(Slot) * NodesPerChunk; }
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    union alignas(T) Slot {
+        FreeSlot free;
+        unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<void*> chunks_;
+    size_t used_ = 0;
+    size_t live_ = 0;
+    FreeSlot* freeList_ = nullptr;
+};
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef NODE_SEARCH_H
+#define NODE_SEARCH_H
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NODE_SEARCH_X86 1
+#endif
+
+// Kernel pencarian di dalam satu node B+ tree untuk key int. Semua key node
+// dibandingkan sekaligus dan hasilnya dihitung (movemask + popcount), bukan
+// berhenti di key pertama yang lebih besar. Varian AVX2/SSE4.2/skalar dipilih
+// saat runtime sesuai CPU.
+enum class SearchKernel { Scalar, Sse42, Avx2 };
+
+namespace node_search {
+
+// Jumlah key yang <= key (= index anak / upper_bound).
+inline int countLessEqualScalar(const int* keys, int n, int key) {
+    int c = 0;
+    for (int i = 0; i < n; i++) c += keys[i] <= key;
+    return c;
+}
+
+// Jumlah key yang < key (= lower_bound).
+inline int countLessScalar(const int* keys, int n, int key) {
+    int c = 0;
+    for (int i = 0; i < n; i++) c += keys[i] < key;
+    return c;
+}
+
+#ifdef NODE_SEARCH_X86
+__attribute__((target("sse4.2,popcnt")))
+inline int countLessEqualSse42(const int* keys, int n, int key) {
+    __m128i k = _mm_set1_epi32(key);
+    int c = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        int greater = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(block, k)));
+        c += 4 - _mm_popcnt_u32(greater);
+    }
+    for (; i < n; i++) c += keys[i] <= key;
+    return c;
+}
+
+__attribute__((target("sse4.2,popcnt")))
+inline int countLessSse42(const int* keys, int n, int key) {
+    __m128i k = _mm_set1_epi32(key);
+    int c = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        c += _mm_popcnt_u32(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(k, block))));
+    }
+    for (; i < n; i++) c += keys[i] < key;
+    return c;
+}
+
+__attribute__((target("avx2,popcnt")))
+inline int countLessEqualAvx2(const int* keys, int n, int key) {
+    __m256i k = _mm256_set1_epi32(key);
+    int c = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        int greater = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(block, k)));
+        c += 8 - _mm_popcnt_u32(greater);
+    }
+    for (; i < n; i++) c += keys[i] <= key;
+    return c;
+}
+
+__attribute__((target("avx2,popcnt")))
+inline int countLessAvx2(const int* keys, int n, int key) {
+    __m256i k = _mm256_set1_epi32(key);
+    int c = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        c += _mm_popcnt_u32(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(k, block))));
+    }
+    for (; i < n; i++) c += keys[i] < key;
+    return c;
+}
+#endif
+
+typedef int (*CountFn)(const int*, int, int);
+
+inline SearchKernel detect() {
+#ifdef NODE_SEARCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) return SearchKernel::Avx2;
+    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) return SearchKernel::Sse42;
+#endif
+    return SearchKernel::Scalar;
+}
+
+struct Dispatch {
+    SearchKernel kernel;
+    CountFn countLessEqual;
+    CountFn countLess;
+};
+
+inline Dispatch makeDispatch(SearchKernel kernel) {
+#ifdef NODE_SEARCH_X86
+    if (kernel == SearchKernel::Avx2) return {kernel, countLessEqualAvx2, countLessAvx2};
+    if (kernel == SearchKernel::Sse42) return {kernel, countLessEqualSse42, countLessSse42};
+#endif
+    return {SearchKernel::Scalar, countLessEqualScalar, countLessScalar};
+}
+
+inline Dispatch active = makeDispatch(detect());
+
+}  // namespace node_search
+
+// Pilih kernel secara manual (misal untuk benchmark). Kernel yang tidak
+// didukung CPU jatuh ke varian skalar.
+inline void useSearchKernel(SearchKernel kernel) {
+    if (kernel > node_search::detect()) kernel = SearchKernel::Scalar;
+    node_search::active = node_search::makeDispatch(kernel);
+}
+
+inline SearchKernel activeSearchKernel() { return node_search::active.kernel; }
+
+inline const char* searchKernelName(SearchKernel kernel) {
+    switch (kernel) {
+        case SearchKernel::Avx2: return "avx2";
+        case SearchKernel::Sse42: return "sse4.2";
+        default: return "scalar";
+    }
+}
+
+// Index anak yang diikuti saat turun: jumlah key node yang <= key.
+inline int nodeUpperBound(const int* keys, int n, int key) {
+    return node_search::active.countLessEqual(keys, n, key);
+}
+
+// Posisi pertama yang key-nya >= key.
+inline int nodeLowerBound(const int* keys, int n, int key) {
+    return node_search::active.countLess(keys, n, key);
+}
+
+#endif
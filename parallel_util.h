@@ -0,0 +1,124 @@
+#ifndef PARALLEL_UTIL_H
+#define PARALLEL_UTIL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+// Bantuan paralel kecil di atas std::thread (tanpa TBB / std::execution,
+// yang di libstdc++ butuh TBB). Thread pemanggil ikut bekerja sebagai
+// thread 0.
+
+// Jalankan fn(t) untuk t = 0..threads-1, masing-masing di thread sendiri.
+template <typename Fn>
+void runThreads(unsigned threads, Fn fn) {
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) workers.emplace_back(fn, t);
+    fn(0);
+    for (std::thread& w : workers) w.join();
+}
+
+// Bagi [0, n) menjadi rentang berurutan dan jalankan fn(lo, hi) per rentang.
+// Pekerjaan kecil dijalankan langsung tanpa thread.
+template <typename Fn>
+void parallelFor(unsigned threads, size_t n, Fn fn, size_t minPerThread = 4096) {
+    unsigned t = (unsigned)std::max<size_t>(1, std::min<size_t>(threads, n / minPerThread));
+    if (t <= 1) {
+        fn(size_t(0), n);
+        return;
+    }
+    runThreads(t, [&](unsigned i) { fn(n * i / t, n * (i + 1) / t); });
+}
+
+// Merge sort paralel: setiap thread mengurutkan satu potongan dengan
+// std::sort, lalu potongan digabung berpasangan per putaran. Setiap
+// penggabungan dibagi lagi ke semua thread: run kiri dipotong rata dan titik
+// potong di run kanan dicari dengan lower_bound, jadi putaran terakhir pun
+// tidak jatuh ke satu thread. Stabil terhadap urutan antar potongan (elemen
+// sama dari run kiri tetap di depan).
+template <typename T, typename Compare>
+void parallelSort(std::vector<T>& v, Compare comp, unsigned threads) {
+    size_t n = v.size();
+    if (threads <= 1 || n < 2 * 4096) {
+        std::sort(v.begin(), v.end(), comp);
+        return;
+    }
+
+    std::vector<size_t> bounds;
+    for (unsigned t = 0; t <= threads; t++) bounds.push_back(n * t / threads);
+    runThreads(threads, [&](unsigned t) { std::sort(v.begin() + bounds[t], v.begin() + bounds[t + 1], comp); });
+
+    struct Task {
+        size_t aLo, aHi, bLo, bHi, out;
+    };
+    std::vector<T> merged(n);
+    while (bounds.size() > 2) {
+        std::vector<Task> tasks;
+        std::vector<size_t> next;
+        for (size_t k = 0; k + 1 < bounds.size(); k += 2) {
+            next.push_back(bounds[k]);
+            size_t lo = bounds[k], mid = bounds[k + 1];
+            size_t hi = k + 2 < bounds.size() ? bounds[k + 2] : mid;
+            // Posisi di run kanan yang berpasangan dengan posisi pos di run kiri.
+            auto split = [&](size_t pos) -> size_t {
+                if (pos == lo) return mid;
+                if (pos == mid) return hi;
+                return std::lower_bound(v.begin() + mid, v.begin() + hi, v[pos], comp) - v.begin();
+            };
+            for (unsigned p = 0; p < threads; p++) {
+                size_t aLo = lo + (mid - lo) * p / threads;
+                size_t aHi = lo + (mid - lo) * (p + 1) / threads;
+                size_t bLo = split(aLo), bHi = split(aHi);
+                if (aLo < aHi || bLo < bHi) tasks.push_back(Task{aLo, aHi, bLo, bHi, aLo + bLo - mid});
+            }
+        }
+        next.push_back(n);
+        parallelFor(threads, tasks.size(), [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; i++) {
+                const Task& t = tasks[i];
+                std::merge(std::make_move_iterator(v.begin() + t.aLo), std::make_move_iterator(v.begin() + t.aHi),
+                           std::make_move_iterator(v.begin() + t.bLo), std::make_move_iterator(v.begin() + t.bHi),
+                           merged.begin() + t.out, comp);
+            }
+        }, 1);
+        v.swap(merged);
+        bounds.swap(next);
+    }
+}
+
+// Buang elemen yang sama dengan elemen sebelumnya (seperti std::unique pada
+// data terurut). Tanda simpan dihitung dulu untuk semua elemen, baru elemen
+// dipindah ke buffer baru pada offset hasil prefix sum per potongan.
+template <typename T, typename Equal>
+void parallelUnique(std::vector<T>& v, Equal equal, unsigned threads) {
+    size_t n = v.size();
+    if (threads <= 1 || n < 2 * 4096) {
+        v.erase(std::unique(v.begin(), v.end(), equal), v.end());
+        return;
+    }
+
+    std::vector<char> keep(n);
+    std::vector<size_t> counts(threads + 1, 0);
+    runThreads(threads, [&](unsigned t) {
+        size_t kept = 0;
+        for (size_t i = n * t / threads; i < n * (t + 1) / threads; i++) {
+            keep[i] = i == 0 || !equal(v[i - 1], v[i]);
+            kept += keep[i];
+        }
+        counts[t + 1] = kept;
+    });
+    for (unsigned t = 0; t < threads; t++) counts[t + 1] += counts[t];
+
+    std::vector<T> out(counts[threads]);
+    runThreads(threads, [&](unsigned t) {
+        size_t w = counts[t];
+        for (size_t i = n * t / threads; i < n * (t + 1) / threads; i++) {
+            if (keep[i]) out[w++] = std::move(v[i]);
+        }
+    });
+    v.swap(out);
+}
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef STRING_KEY_H
+#define STRING_KEY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "memory_stats.h"
+
+// Key string 24 byte untuk B+ tree. 8 byte pertama disimpan juga sebagai
+// bilangan big-endian (head), jadi urutan leksikografis = urutan integer dan
+// hampir semua perbandingan selesai dengan satu compare uint64. String sampai
+// INLINE_BYTES disimpan seluruhnya di dalam key (nama orang hampir selalu
+// muat); yang lebih panjang disalin ke heap.
+class StringKey {
+public:
+    static const size_t INLINE_BYTES = 16;
+
+    StringKey() : head_(0), size_(0) { rest_.inlineTail = 0; }
+    StringKey(std::string_view s) { assign(s.data(), s.size()); }
+    StringKey(const std::string& s) { assign(s.data(), s.size()); }
+    StringKey(const char* s) { assign(s, strlen(s)); }
+
+    StringKey(const StringKey& other) { copyFrom(other); }
+    StringKey(StringKey&& other) noexcept : head_(other.head_), rest_(other.rest_), size_(other.size_) {
+        other.head_ = 0;
+        other.size_ = 0;
+    }
+
+    StringKey& operator=(const StringKey& other) {
+        if (this != &other) {
+            release();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    StringKey& operator=(StringKey&& other) noexcept {
+        if (this != &other) {
+            release();
+            head_ = other.head_;
+            rest_ = other.rest_;
+            size_ = other.size_;
+            other.head_ = 0;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~StringKey() { release(); }
+
+    size_t size() const { return size_; }
+    bool isInline() const { return size_ <= INLINE_BYTES; }
+    std::string str() const { return std::string(data(), size_); }
+
+    // Byte string berurutan. Untuk key inline, 8 byte pertama dibangun ulang
+    // dari head ke buffer thread_local, jadi hanya untuk tampilan/salinan.
+    const char* data() const {
+        if (!isInline()) return rest_.heap;
+        thread_local char buffer[INLINE_BYTES];
+        for (int i = 0; i < 8; i++) buffer[i] = (char)(head_ >> (56 - 8 * i));
+        memcpy(buffer + 8, &rest_.inlineTail, 8);
+        return buffer;
+    }
+
+    const void* heapData() const { return isInline() ? nullptr : rest_.heap; }
+
+    friend bool operator<(const StringKey& a, const StringKey& b) { return compare(a, b) < 0; }
+    friend bool operator==(const StringKey& a, const StringKey& b) {
+        if (a.head_ != b.head_ || a.size_ != b.size_) return false;
+        if (a.size_ <= 8) return true;
+        return memcmp(a.tail(), b.tail(), a.size_ - 8) == 0;
+    }
+    friend bool operator!=(const StringKey& a, const StringKey& b) { return !(a == b); }
+
+    friend std::ostream& operator<<(std::ostream& out, const StringKey& k) {
+        return out.write(k.data(), k.size_);
+    }
+
+    // <0, 0, >0 seperti memcmp. Key yang lebih pendek dari 8 byte diisi nol,
+    // jadi kalau head sama, panjang yang menentukan.
+    static int compare(const StringKey& a, const StringKey& b) {
+        if (a.head_ != b.head_) return a.head_ < b.head_ ? -1 : 1;
+        size_t common = std::min(a.size_, b.size_);
+        if (common > 8) {
+            int c = memcmp(a.tail(), b.tail(), common - 8);
+            if (c != 0) return c;
+        }
+        return a.size_ < b.size_ ? -1 : (a.size_ > b.size_ ? 1 : 0);
+    }
+
+private:
+    uint64_t head_;
+    union {
+        uint64_t inlineTail;  // byte 8..15 apa adanya, sisa diisi nol
+        char* heap;           // seluruh string kalau lebih dari INLINE_BYTES
+    } rest_;
+    uint32_t size_;
+
+    void assign(const char* s, size_t n) {
+        size_ = (uint32_t)n;
+        head_ = 0;
+        for (size_t i = 0; i < 8 && i < n; i++) head_ |= (uint64_t)(unsigned char)s[i] << (56 - 8 * i);
+        if (n <= INLINE_BYTES) {
+            rest_.inlineTail = 0;
+            if (n > 8) memcpy(&rest_.inlineTail, s + 8, n - 8);
+        } else {
+            rest_.heap = new char[n];
+            memcpy(rest_.heap, s, n);
+        }
+    }
+
+    void copyFrom(const StringKey& other) {
+        if (other.isInline()) {
+            head_ = other.head_;
+            rest_ = other.rest_;
+            size_ = other.size_;
+        } else {
+            assign(other.rest_.heap, other.size_);
+        }
+    }
+
+    void release() {
+        if (!isInline()) delete[] rest_.heap;
+        size_ = 0;
+    }
+
+    // Byte mulai index 8 (valid kalau size_ > 8).
+    const char* tail() const {
+        return isInline() ? reinterpret_cast<const char*>(&rest_.inlineTail) : rest_.heap + 8;
+    }
+};
+
+inline size_t ownedHeapBytes(const StringKey& k) { return heapBlockBytes(k.heapData()); }
+
+// Separator terpendek s dengan left < s <= right: prefix right sampai satu
+// byte setelah bagian yang sama dengan left. Separator pendek biasanya muat
+// inline walaupun key-nya sendiri panjang. Hanya untuk urutan std::less;
+// Compare lain jatuh ke versi umum di bplus_tree.h (separator = right).
+inline StringKey separatorBetween(const StringKey& left, const StringKey& right, const std::less<StringKey>&) {
+    if (right.size() <= 8) return right;
+    std::string l = left.str(), r = right.str();
+    size_t common = 0;
+    while (common < l.size() && common < r.size() && l[common] == r[common]) common++;
+    return StringKey(std::string_view(r.data(), std::min(r.size(), common + 1)));
+}
+
+inline StringKey separatorBetween(const StringKey& left, const StringKey& right, const std::less<>&) {
+    return separatorBetween(left, right, std::less<StringKey>());
+}
+
+#endif
@@ -0,0 +1,238 @@
+#include <iostream>
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include "bplus_tree.h"
+#include "string_key.h"
+
+using namespace std;
+
+// Uji acak BPlusTree terhadap std::map: insert, upsert, put, get, erase,
+// update, insertBatch, eraseBatch, search, rangeCount, seek, dan iterator di
+// beberapa Order, mode hapus Rebalance dan Lazy. Value std::string (lebih dari
+// 16 byte) ikut menguji value di heap. Setelah setiap putaran isi tree
+// dibandingkan penuh dengan model, lalu tree dikosongkan sampai habis.
+// Berguna juga dengan -fsanitize=address,undefined.
+
+int failures = 0;
+
+void check(bool ok, const string& what) {
+    if (!ok && failures++ < 20) cerr << "GAGAL: " << what << "\n";
+}
+
+string valueFor(int key, int version) {
+    return "value-" + to_string(key) + "-" + to_string(version) + string(12, 'x');
+}
+
+template <typename Tree>
+void compareAll(const Tree& tree, const map<int, string>& model, const string& where) {
+    check(tree.size() == model.size(), where + ": size");
+    check(tree.empty() == model.empty(), where + ": empty");
+    auto it = tree.begin();
+    for (const auto& kv : model) {
+        if (it == tree.end() || it.key() != kv.first || it.value() != kv.second) {
+            check(false, where + ": isi iterator berbeda di key " + to_string(kv.first));
+            return;
+        }
+        ++it;
+    }
+    check(it == tree.end(), where + ": iterator lebih panjang dari model");
+    check(tree.memoryStats().keys == model.size(), where + ": memoryStats().keys");
+}
+
+template <int Order>
+void randomOps(BPlusDeleteMode mode, unsigned seed, int rounds, int opsPerRound) {
+    string name = "Order " + to_string(Order) + (mode == BPlusDeleteMode::Lazy ? " lazy" : " rebalance") +
+                  " seed " + to_string(seed);
+    BPlusTree<int, string, Order> tree;
+    tree.setDeleteMode(mode);
+    map<int, string> model;
+    mt19937 rng(seed);
+    const int RANGE = 4000;
+    int version = 0;
+
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < opsPerRound; i++) {
+            int key = rng() % RANGE;
+            int op = rng() % 100;
+            if (op < 30) {
+                string v = valueFor(key, ++version);
+                bool inserted = tree.insert(key, v);
+                check(inserted == model.emplace(key, v).second, name + ": insert");
+            } else if (op < 40) {
+                string v = valueFor(key, ++version);
+                bool inserted = tree.upsert(key, v);
+                check(inserted == !model.count(key), name + ": upsert");
+                model[key] = v;
+            } else if (op < 45) {
+                string v = valueFor(key, ++version);
+                check(tree.put(key, v) == v, name + ": put");
+                model[key] = v;
+            } else if (op < 65) {
+                string removed;
+                auto found = model.find(key);
+                bool erased = tree.erase(key, &removed);
+                check(erased == (found != model.end()), name + ": erase");
+                if (found != model.end()) {
+                    check(removed == found->second, name + ": value hasil erase");
+                    model.erase(found);
+                }
+            } else if (op < 75) {
+                int to = rng() % RANGE;
+                // update ke key yang sama dianggap berhasil tanpa perubahan.
+                bool ok = model.count(key) && (to == key || !model.count(to));
+                check(tree.update(key, to) == ok, name + ": update");
+                if (ok && to != key) {
+                    model[to] = model[key];
+                    model.erase(key);
+                }
+            } else if (op < 90) {
+                const string* v = tree.get(key);
+                auto found = model.find(key);
+                check((v != nullptr) == (found != model.end()) && (!v || *v == found->second), name + ": get");
+                check(tree.search(key) == (found != model.end()), name + ": search");
+                auto seek = tree.seek(key);
+                auto lower = model.lower_bound(key);
+                check((seek == tree.end()) == (lower == model.end()) && (seek == tree.end() || seek.key() == lower->first),
+                      name + ": seek");
+            } else if (op < 95) {
+                int hi = key + rng() % 500;
+                size_t expected = distance(model.lower_bound(key), model.upper_bound(hi));
+                check(tree.rangeCount(key, hi) == expected, name + ": rangeCount");
+            } else if (op < 98) {
+                vector<int> batch(1 + rng() % 200);
+                for (int& k : batch) k = rng() % RANGE;
+                size_t expected = 0;
+                for (int k : batch) expected += model.emplace(k, string()).second;
+                check(tree.insertBatch(batch.begin(), batch.end()) == expected, name + ": insertBatch");
+            } else {
+                vector<int> batch(1 + rng() % 200);
+                for (int& k : batch) k = rng() % RANGE;
+                size_t expected = 0;
+                for (int k : batch) expected += model.erase(k);
+                check(tree.eraseBatch(batch.begin(), batch.end()) == expected, name + ": eraseBatch");
+            }
+        }
+        compareAll(tree, model, name + " putaran " + to_string(round));
+    }
+
+    // Kosongkan dalam urutan acak: tree harus kembali kosong.
+    vector<int> rest;
+    for (const auto& kv : model) rest.push_back(kv.first);
+    shuffle(rest.begin(), rest.end(), rng);
+    for (int key : rest) check(tree.remove(key), name + ": remove saat dikosongkan");
+    model.clear();
+    compareAll(tree, model, name + " setelah dikosongkan");
+    check(tree.insert(7, "lagi") && tree.search(7), name + ": insert setelah kosong");
+}
+
+template <int Order>
+void bulkBuilds(unsigned seed) {
+    string name = "build Order " + to_string(Order);
+    mt19937 rng(seed);
+    vector<int> keys(50000);
+    for (int& k : keys) k = rng() % 40000;
+    map<int, string> model;
+    for (int k : keys) model.emplace(k, string());
+
+    for (unsigned threads : {1u, 2u, 4u}) {
+        BPlusTree<int, string, Order> tree;
+        check(tree.buildParallel(keys.begin(), keys.end(), threads), name + ": buildParallel");
+        compareAll(tree, model, name + " buildParallel " + to_string(threads) + " thread");
+        check(!tree.buildParallel(keys.begin(), keys.end(), threads), name + ": buildParallel tree tidak kosong");
+    }
+
+    BPlusTree<int, string, Order> tree;
+    tree.insertBatch(keys.begin(), keys.end());
+    compareAll(tree, model, name + " insertBatch tree kosong");
+    for (double fill : {0.5, 1.0}) {
+        tree.compact(fill);
+        compareAll(tree, model, name + " compact " + to_string(fill));
+    }
+}
+
+// Key string dengan Compare bawaan dan std::greater. Suffix truncation
+// separator hanya berlaku untuk urutan std::less; dengan Compare lain
+// separator pendek bisa salah arah dan search gagal untuk key yang ada.
+// StringKey hanya punya operator<.
+struct StringKeyGreater {
+    bool operator()(const StringKey& a, const StringKey& b) const { return b < a; }
+};
+
+// Model std::set<string> dengan urutan yang sama dengan Compare tree.
+template <typename Compare>
+struct ModelOrder {
+    typedef Compare type;
+};
+template <>
+struct ModelOrder<less<StringKey>> {
+    typedef less<string> type;
+};
+template <>
+struct ModelOrder<StringKeyGreater> {
+    typedef greater<string> type;
+};
+
+template <typename Key, typename Compare, int Order>
+void stringKeys(const string& name, unsigned seed) {
+    BPlusTree<Key, BPlusEmpty, Order, Compare> tree;
+    set<string, typename ModelOrder<Compare>::type> model;
+    mt19937 rng(seed);
+    for (int i = 0; i < 3000; i++) {
+        string s(1 + rng() % 12, 'a');
+        for (char& c : s) c = 'a' + rng() % 3;
+        Key key(s);
+        if (rng() % 4) {
+            check(tree.insert(key) == model.insert(s).second, name + ": insert");
+        } else {
+            check(tree.remove(key) == (model.erase(s) == 1), name + ": remove");
+        }
+    }
+    check(tree.size() == model.size(), name + ": size");
+    for (const string& s : model) check(tree.search(Key(s)), name + ": search key " + s);
+    auto it = tree.begin();
+    for (const string& s : model) {
+        if (it == tree.end() || !(it.key() == Key(s))) {
+            check(false, name + ": urutan iterator berbeda di key " + s);
+            break;
+        }
+        ++it;
+    }
+
+    vector<Key> keys;
+    for (const string& s : model) keys.push_back(Key(s));
+    shuffle(keys.begin(), keys.end(), rng);
+    BPlusTree<Key, BPlusEmpty, Order, Compare> built;
+    check(built.buildParallel(keys.begin(), keys.end(), 2), name + ": buildParallel");
+    for (const string& s : model) check(built.search(Key(s)), name + ": search setelah buildParallel " + s);
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? atoi(argv[1]) : 20;
+    for (unsigned seed = 1; seed <= 3; seed++) {
+        for (BPlusDeleteMode mode : {BPlusDeleteMode::Rebalance, BPlusDeleteMode::Lazy}) {
+            randomOps<3>(mode, seed, rounds, 2000);
+            randomOps<4>(mode, seed, rounds, 2000);
+            randomOps<5>(mode, seed, rounds, 2000);
+            randomOps<16>(mode, seed, rounds, 2000);
+            randomOps<64>(mode, seed, rounds, 2000);
+        }
+        bulkBuilds<4>(seed);
+        bulkBuilds<64>(seed);
+        stringKeys<string, less<string>, 4>("string less", seed);
+        stringKeys<string, greater<string>, 4>("string greater", seed);
+        stringKeys<StringKey, less<StringKey>, 4>("StringKey less", seed);
+        stringKeys<StringKey, StringKeyGreater, 4>("StringKey greater", seed);
+    }
+    if (failures) {
+        cerr << failures << " pemeriksaan gagal\n";
+        return 1;
+    }
+    cout << "Semua uji lulus\n";
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <set>
+#include <cstdlib>
+#include "bplus_concurrent.h"
+
+using namespace std;
+
+// Uji stres ConcurrentBPlusTree: beberapa penulis insert/remove di rentang
+// key masing-masing sementara pembaca terus mencari key tetap yang tidak
+// pernah dihapus (tidak boleh ada false negative). Setelah semua thread
+// selesai isi tree dibandingkan dengan std::set per penulis. Jalankan juga
+// di bawah -fsanitize=thread untuk memeriksa data race.
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        cerr << "GAGAL: " << what << "\n";
+        failures++;
+    }
+}
+
+template <int Order>
+void stress(int writers, int readers, int opsPerWriter, unsigned seed) {
+    ConcurrentBPlusTree<int, int, Order> tree;
+    // Key tetap: kelipatan 3 yang negatif, di luar rentang penulis.
+    const int STABLE = 2000;
+    for (int i = 1; i <= STABLE; i++) tree.insert(-3 * i, i);
+
+    atomic<bool> done{false};
+    atomic<long> misses{0};
+    vector<set<int>> expected(writers);
+    vector<thread> threads;
+    for (int w = 0; w < writers; w++) {
+        threads.emplace_back([&, w] {
+            mt19937 rng(seed + w);
+            set<int>& mine = expected[w];
+            int base = w * 100000;
+            for (int i = 0; i < opsPerWriter; i++) {
+                int key = base + rng() % 5000;
+                if (rng() % 3) {
+                    bool inserted = tree.insert(key, key * 2);
+                    if (inserted != mine.insert(key).second) misses++;
+                } else {
+                    bool removed = tree.remove(key);
+                    if (removed != (mine.erase(key) == 1)) misses++;
+                }
+            }
+        });
+    }
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&, r] {
+            mt19937 rng(seed * 31 + r);
+            while (!done.load(memory_order_relaxed)) {
+                int i = 1 + rng() % STABLE;
+                int value = 0;
+                if (!tree.search(-3 * i, &value) || value != i) misses++;
+                tree.search(-3 * i - 1);  // tidak pernah ada
+            }
+        });
+    }
+    for (int w = 0; w < writers; w++) threads[w].join();
+    done = true;
+    for (size_t t = writers; t < threads.size(); t++) threads[t].join();
+
+    check(misses == 0, "hasil insert/remove/search berbeda dari model");
+    size_t total = STABLE;
+    for (int w = 0; w < writers; w++) {
+        total += expected[w].size();
+        for (int key = w * 100000; key < w * 100000 + 5000; key++) {
+            int value = 0;
+            bool found = tree.search(key, &value);
+            bool want = expected[w].count(key) > 0;
+            check(found == want && (!found || value == key * 2), "isi akhir berbeda dari model");
+        }
+    }
+    check(tree.size() == total, "size() berbeda dari model");
+    cout << "Order " << Order << ": " << writers << " penulis, " << readers << " pembaca, " << tree.size()
+         << " key akhir\n";
+}
+
+int main(int argc, char* argv[]) {
+    int ops = argc > 1 ? atoi(argv[1]) : 20000;
+    for (unsigned seed = 1; seed <= 3; seed++) {
+        stress<4>(4, 2, ops, seed);
+        stress<8>(3, 3, ops, seed);
+        stress<64>(4, 4, ops, seed);
+    }
+    if (failures) {
+        cerr << failures << " pemeriksaan gagal\n";
+        return 1;
+    }
+    cout << "Semua uji lulus\n";
+    return 0;
+}
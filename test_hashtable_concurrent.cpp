@@ -0,0 +1,102 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <set>
+#include <cstdlib>
+#include "hashtable_concurrent.h"
+
+using namespace std;
+
+// Uji stres ConcurrentHashTable: penulis insert/remove di rentang key
+// masing-masing sementara pembaca terus mencari key tetap (harus selalu
+// ketemu) dan key yang tidak pernah ada (tidak boleh ketemu). Tabel mulai
+// kecil supaya resize online terjadi berkali-kali selama uji. Key int dan
+// string panjang (node besar, perbandingan lewat heap). Jalankan juga di
+// bawah -fsanitize=address dan -fsanitize=thread; untuk TSan pakai
+// TSAN_OPTIONS=detect_deadlocks=0 karena resize memegang 65 mutex sekaligus
+// dan detektor deadlock TSan hanya menampung 64.
+
+int failures = 0;
+
+void check(bool ok, const string& what) {
+    if (!ok) {
+        cerr << "GAGAL: " << what << "\n";
+        failures++;
+    }
+}
+
+int intKey(int i) { return i; }
+string stringKey(int i) { return "key-panjang-di-luar-sso-" + to_string(i) + "-" + string(24, 'z'); }
+
+template <typename Key, typename MakeKey>
+void stress(const string& name, MakeKey makeKey, int writers, int readers, int opsPerWriter, unsigned seed) {
+    ConcurrentHashTable<Key> table(64);
+    // Key tetap: negatif, di luar rentang penulis (rentang w * 1000000 ke atas).
+    const int STABLE = 2000;
+    for (int i = 1; i <= STABLE; i++) table.insert(makeKey(-i));
+
+    atomic<bool> done{false};
+    atomic<long> errors{0};
+    vector<set<int>> expected(writers);
+    vector<thread> threads;
+    for (int w = 0; w < writers; w++) {
+        threads.emplace_back([&, w] {
+            mt19937 rng(seed + w);
+            set<int>& mine = expected[w];
+            for (int i = 0; i < opsPerWriter; i++) {
+                int id = w * 1000000 + rng() % 20000;
+                if (rng() % 4) {
+                    if (table.insert(makeKey(id)) != mine.insert(id).second) errors++;
+                } else {
+                    if (table.remove(makeKey(id)) != (mine.erase(id) == 1)) errors++;
+                }
+            }
+        });
+    }
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&, r] {
+            mt19937 rng(seed * 31 + r);
+            while (!done.load(memory_order_relaxed)) {
+                int i = 1 + rng() % STABLE;
+                if (!table.search(makeKey(-i))) errors++;
+                if (table.search(makeKey(-i - STABLE))) errors++;
+            }
+        });
+    }
+    for (int w = 0; w < writers; w++) threads[w].join();
+    done = true;
+    for (size_t t = writers; t < threads.size(); t++) threads[t].join();
+
+    check(errors == 0, name + ": hasil insert/remove/search berbeda dari model");
+    size_t total = STABLE;
+    for (int w = 0; w < writers; w++) {
+        total += expected[w].size();
+        for (int id = w * 1000000; id < w * 1000000 + 20000; id++) {
+            if (table.search(makeKey(id)) != (expected[w].count(id) > 0)) {
+                check(false, name + ": isi akhir berbeda dari model");
+                break;
+            }
+        }
+    }
+    check(table.size() == total, name + ": size() berbeda dari model");
+    check(table.resizes() > 0, name + ": tidak ada resize selama uji");
+    cout << name << ": " << writers << " penulis, " << readers << " pembaca, " << table.size() << " key, "
+         << table.resizes() << " resize\n";
+}
+
+int main(int argc, char* argv[]) {
+    int ops = argc > 1 ? atoi(argv[1]) : 40000;
+    for (unsigned seed = 1; seed <= 3; seed++) {
+        stress<int>("int", intKey, 4, 4, ops, seed);
+        stress<string>("string", stringKey, 4, 4, ops / 2, seed);
+    }
+    if (failures) {
+        cerr << failures << " pemeriksaan gagal\n";
+        return 1;
+    }
+    cout << "Semua uji lulus\n";
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <unordered_set>
+#include <cstdlib>
+#include "hashtable_incremental.h"
+
+using namespace std;
+
+// Uji acak IncrementalHashTable terhadap std::unordered_set dengan
+// migrateStep 0 (rehash stop-the-world), 1, 8, dan 64. Key sengaja diambil
+// dari rentang kecil supaya insert, remove, dan search sering jatuh pada
+// bucket yang belum dipindah selama migrasi. Setiap beberapa operasi isi
+// tabel dicocokkan dengan model, termasuk memoryStats() yang menelusuri
+// array lama dan baru (setiap key harus terhitung tepat sekali). Berguna
+// juga dengan -fsanitize=address,undefined.
+
+int failures = 0;
+
+void check(bool ok, const string& what) {
+    if (!ok && failures++ < 20) cerr << "GAGAL: " << what << "\n";
+}
+
+template <typename Key, typename MakeKey>
+void randomOps(const string& keyName, MakeKey makeKey, size_t step, unsigned seed, int ops) {
+    string name = keyName + " step " + to_string(step) + " seed " + to_string(seed);
+    IncrementalHashTable<Key> table(2, 1.0, step);
+    unordered_set<Key> model;
+    mt19937 rng(seed);
+    size_t duringMigration = 0;
+    int range = 1000;
+    int iterations = 0;
+
+    for (int i = 0; i < ops; i++) {
+        // Rentang key melebar bertahap supaya tabel terus tumbuh.
+        if (i % 5000 == 0) range *= 2;
+        Key key = makeKey(rng() % range);
+        int op = rng() % 10;
+        duringMigration += table.migrating();
+        if (op < 5) {
+            check(table.insert(key) == model.insert(key).second, name + ": insert");
+        } else if (op < 7) {
+            check(table.remove(key, iterations) == (model.erase(key) == 1), name + ": remove");
+        } else {
+            check(table.search(key, iterations) == (model.count(key) > 0), name + ": search");
+        }
+        if (i % 997 == 0) {
+            check(table.size() == model.size(), name + ": size");
+            check(table.memoryStats().keys == model.size(), name + ": memoryStats().keys");
+        }
+    }
+    for (const Key& key : model) check(table.search(key, iterations), name + ": key hilang di akhir");
+    check(table.size() == model.size(), name + ": size akhir");
+    check(table.resizes() > 5, name + ": terlalu sedikit resize");
+    if (step > 0) check(duringMigration > 0, name + ": tidak pernah ada operasi selama migrasi");
+    cout << name << ": " << table.size() << " key, " << table.bucketCount() << " bucket, " << table.resizes()
+         << " resize, " << duringMigration << " operasi selama migrasi\n";
+
+    // Kosongkan; tabel harus tetap konsisten setelah semua node dibuang.
+    for (const Key& key : model) check(table.remove(key, iterations), name + ": remove saat dikosongkan");
+    check(table.size() == 0 && table.memoryStats().keys == 0, name + ": tidak kosong setelah dikosongkan");
+}
+
+int main(int argc, char* argv[]) {
+    int ops = argc > 1 ? atoi(argv[1]) : 60000;
+    for (unsigned seed = 1; seed <= 3; seed++) {
+        for (size_t step : {0, 1, 8, 64}) {
+            randomOps<uint64_t>("uint64", [](uint64_t i) { return i * 0x9E3779B97F4A7C15ULL; }, step, seed, ops);
+            randomOps<string>("string", [](uint64_t i) { return "nama-" + to_string(i) + string(20, 'q'); }, step,
+                              seed, ops / 2);
+        }
+    }
+    if (failures) {
+        cerr << failures << " pemeriksaan gagal\n";
+        return 1;
+    }
+    cout << "Semua uji lulus\n";
+    return 0;
+}
@@ -0,0 +1,91 @@
+#ifndef VALUE_STORAGE_H
+#define VALUE_STORAGE_H
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "memory_stats.h"
+
+// Payload kosong untuk struktur yang hanya menyimpan key.
+struct BPlusEmpty {};
+
+// Value sampai INLINE_VALUE_BYTES disimpan langsung di leaf/slot. Yang lebih
+// besar disimpan di heap dan leaf/slot hanya memegang pointer, jadi node
+// tetap kecil dan menggeser entri cukup memindah satu pointer.
+const size_t INLINE_VALUE_BYTES = 16;
+
+template <typename Value>
+class OutOfLineValue {
+public:
+    OutOfLineValue() = default;
+    OutOfLineValue(const Value& v) : ptr_(new Value(v)) {}
+    OutOfLineValue(Value&& v) : ptr_(new Value(std::move(v))) {}
+    OutOfLineValue(const OutOfLineValue& other) : ptr_(other.ptr_ ? new Value(*other.ptr_) : nullptr) {}
+    OutOfLineValue(OutOfLineValue&&) noexcept = default;
+
+    OutOfLineValue& operator=(const OutOfLineValue& other) {
+        if (this != &other) *this = other.ptr_ ? OutOfLineValue(*other.ptr_) : OutOfLineValue();
+        return *this;
+    }
+    OutOfLineValue& operator=(OutOfLineValue&&) noexcept = default;
+
+    // Menimpa value yang sudah ada memakai blok heap yang sama.
+    OutOfLineValue& operator=(const Value& v) {
+        if (ptr_) {
+            *ptr_ = v;
+        } else {
+            ptr_.reset(new Value(v));
+        }
+        return *this;
+    }
+
+    // Hanya boleh dipanggil untuk entri yang hidup (sudah diberi value).
+    Value& get() { return *ptr_; }
+    const Value& get() const { return *ptr_; }
+    const Value* ptr() const { return ptr_.get(); }
+
+private:
+    std::unique_ptr<Value> ptr_;
+};
+
+template <typename Value>
+using StoredValue = typename std::conditional<(sizeof(Value) <= INLINE_VALUE_BYTES), Value,
+                                              OutOfLineValue<Value>>::type;
+
+template <typename Value>
+Value& loadValue(Value& v) { return v; }
+template <typename Value>
+const Value& loadValue(const Value& v) { return v; }
+template <typename Value>
+Value& loadValue(OutOfLineValue<Value>& v) { return v.get(); }
+template <typename Value>
+const Value& loadValue(const OutOfLineValue<Value>& v) { return v.get(); }
+
+template <typename Value>
+size_t ownedHeapBytes(const OutOfLineValue<Value>& v) {
+    return v.ptr() ? heapBlockBytes(v.ptr()) + ownedHeapBytes(*v.ptr()) : 0;
+}
+
+// Array value berkapasitas tetap di leaf/slot. Untuk BPlusEmpty tidak ada
+// byte yang dipakai. ForceInline menyimpan semua value di tempat, berapa pun
+// ukurannya (dipakai tree yang membaca value tanpa kunci).
+template <typename Value, int N, bool ForceInline = false>
+struct ValueArray {
+    using Item = typename std::conditional<ForceInline, Value, StoredValue<Value>>::type;
+    Item items[N];
+
+    Item& operator[](int i) { return items[i]; }
+    const Item& operator[](int i) const { return items[i]; }
+};
+
+template <int N, bool ForceInline>
+struct ValueArray<BPlusEmpty, N, ForceInline> {
+    inline static BPlusEmpty empty;
+
+    BPlusEmpty& operator[](int) { return empty; }
+    const BPlusEmpty& operator[](int) const { return empty; }
+};
+
+#endif